@@ -21,6 +21,11 @@ MenuDisplay menu(display);
 std::shared_ptr<PixelBattery> battery = std::make_shared<PixelBattery>();
 std::shared_ptr<PixelBle> bleIcon = std::make_shared<PixelBle>();
 
+// Value source for the live "Uptime" item
+float readUptimeSeconds() {
+  return millis() / 1000.0f;
+}
+
 void setup() {
   Serial.begin(115200);
   delay(2000); // Allow hardware to stabilize
@@ -40,6 +45,7 @@ void setup() {
 
   // Other main menu items
   auto infoItem = MenuBuilder::createItem("Info");
+  auto uptimeItem = MenuBuilder::createLiveItem("Uptime", readUptimeSeconds, nullptr, 100); // Redrawn only when the text changes
   auto settingsItem = MenuBuilder::createItem("Settings");
   auto aboutItem = MenuBuilder::createItem("About");
 
@@ -48,6 +54,7 @@ void setup() {
     wifiMenu,
     bluetoothMenu,
     infoItem,
+    uptimeItem,
     settingsItem,
     aboutItem
   };
@@ -74,7 +81,7 @@ const unsigned long batteryUpdateInterval = 500;  // milliseconds
 int colorToggleCounter = 0;
 
 void loop() {
-  menu.render(); // Draw menu and status icons
+  menu.update(); // Draw menu and status icons (only what changed)
 
   // === Update battery level and toggle icons every 500ms ===
   if (millis() - lastBatteryUpdate > batteryUpdateInterval) {
@@ -97,6 +104,7 @@ void loop() {
 
     battery->setLevel(batteryLevel);
     lastBatteryUpdate = millis();
+    menu.invalidate(); // Status bar changed, repaint the whole screen
   }
 
   // === Handle Serial Monitor input for menu navigation ===
@@ -0,0 +1,79 @@
+#include "MenuDisplay.h"
+#include "MenuBuilder.h"
+#include "MenuFootprint.h"
+#include "DisplaySH1106.h"
+
+// Prints the RAM taken by the menu and the SH1106 driver with the current build profile
+// (static on AVR) and how much of the item arena a small menu uses. The same menu code
+// builds for ESP32 (dynamic profile); only the sizes differ.
+
+using Footprint = MenuFootprintT<DisplaySH1106>;
+
+// RAM the menu must leave free: the stack (render() and the deepest interrupt) and
+// the receive and transmit buffers of Serial
+#define STACK_RESERVE 256
+#if defined(SERIAL_RX_BUFFER_SIZE) && defined(SERIAL_TX_BUFFER_SIZE)
+#define SERIAL_RESERVE (SERIAL_RX_BUFFER_SIZE + SERIAL_TX_BUFFER_SIZE)
+#else
+#define SERIAL_RESERVE 128
+#endif
+
+// Fails the build if the menu, the 1 KB frame buffer and the reserve do not fit the RAM
+// of the board (checked on AVR, where the toolchain reports it). On a 2 KB part
+// (ATmega328P) lower MENU_ARENA_SIZE or the capacities in MenuConfig.h until it passes.
+static_assert(Footprint::fitsRam(STACK_RESERVE + SERIAL_RESERVE), "menu, frame buffer and stack do not fit the RAM");
+
+// Fails the build if the items built in setup() do not fit the item arena
+static_assert(Footprint::fits(5), "menu items do not fit MENU_ARENA_SIZE");
+
+I2CDisplayBus bus(0x3C);
+DisplaySH1106 display(bus);
+MenuDisplay menu(display);
+
+void printSize(const char* name, size_t bytes) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((unsigned long)bytes);
+  Serial.println(" bytes");
+}
+
+#if MENU_STATIC_PROFILE
+// Reports items that could not be created (they are left out of the menu)
+void arenaOverflow(size_t size) {
+  printSize("Arena full, item not created", size);
+}
+#endif
+
+void setup() {
+  Serial.begin(115200);
+  display.begin();
+#if MENU_STATIC_PROFILE
+  MenuArena::setOverflowHandler(arenaOverflow);
+#endif
+
+  menu.setMenu({
+    MenuBuilder::createMenu("Settings", {
+      MenuBuilder::createItem("WiFi"),
+      MenuBuilder::createItem("Brightness")
+    }),
+    MenuBuilder::createItem("Info"),
+    MenuBuilder::createItem("About")
+  });
+
+  Serial.println(MENU_STATIC_PROFILE ? "Static profile" : "Dynamic profile");
+  printSize("MenuItem", Footprint::ITEM);
+  printSize("LiveMenuItem", Footprint::LIVE_ITEM);
+  printSize("TaskMenuItem", Footprint::TASK_ITEM);
+  printSize("MenuDisplay", Footprint::DISPLAY);
+  printSize("Item arena", Footprint::ARENA);
+  printSize("DisplaySH1106", Footprint::DRIVER);
+  printSize("Total", Footprint::TOTAL);
+  if (Footprint::RAM > 0) printSize("Left for stack and application", Footprint::RAM - Footprint::TOTAL);
+#if MENU_STATIC_PROFILE
+  printSize("Arena used", MenuArena::used());
+  if (MenuArena::overflowed()) Serial.println("Arena overflow: raise MENU_ARENA_SIZE");
+#endif
+}
+
+void loop() {
+}
@@ -0,0 +1,159 @@
+// Checks on the host what DisplaySH1106 sends to the panel.
+//
+// Known frames are drawn into a DisplaySH1106 on a MockDisplayBus, and the recorded
+// transactions are compared with the page and column addresses and the data bytes
+// display() must send: only the changed columns of each page, nothing for an unchanged
+// frame. A menu frame is then rendered and updated, and the controller RAM modelled by
+// the mock must match the frame buffer. Exits with 1 if a check fails.
+//
+// Build from this directory (the Arduino.h of TraceReplay replaces the Arduino core):
+//   g++ -std=c++17 -O2 -I../TraceReplay -I../../src BusCheck.cpp ../../src/*.cpp -o bus-check
+// Run:
+//   ./bus-check
+
+#include "Arduino.h"
+#include "MenuDisplay.h"
+#include "MenuBuilder.h"
+#include "DisplaySH1106.h"
+#include "DisplayBus.h"
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+// Reports a failed check with its line
+#define CHECK(condition)                                          \
+  do {                                                            \
+    if (!(condition)) {                                           \
+      fprintf(stderr, "line %d: %s\n", __LINE__, #condition);     \
+      ++failures;                                                 \
+    }                                                             \
+  } while (0)
+
+// Whether transaction 'index' is the address commands for 'page' at buffer column 'column'
+static bool isAddress(const MockDisplayBus& bus, size_t index, int page, int column) {
+  const auto& transactions = bus.getTransactions();
+  if (index >= transactions.size()) return false;
+  const int ramColumn = column + SH1106_COLUMN_OFFSET;
+  const std::vector<uint8_t> expected = {
+    (uint8_t)(0xB0 | page), (uint8_t)(ramColumn & 0x0F), (uint8_t)(0x10 | (ramColumn >> 4))
+  };
+  return transactions[index].isCommand && transactions[index].bytes == expected;
+}
+
+// Whether transaction 'index' is 'count' data bytes all equal to 'value'
+static bool isData(const MockDisplayBus& bus, size_t index, size_t count, uint8_t value) {
+  const auto& transactions = bus.getTransactions();
+  if (index >= transactions.size() || transactions[index].isCommand) return false;
+  const std::vector<uint8_t>& bytes = transactions[index].bytes;
+  if (bytes.size() != count) return false;
+  for (uint8_t byte : bytes) {
+    if (byte != value) return false;
+  }
+  return true;
+}
+
+// Whether the modelled controller RAM shows the frame buffer of 'display'
+static bool ramMatches(const MockDisplayBus& bus, DisplaySH1106& display) {
+  for (int y = 0; y < SH1106_HEIGHT; ++y) {
+    for (int x = 0; x < SH1106_WIDTH; ++x) {
+      const int ramBit = (bus.getRam(y >> 3, x + SH1106_COLUMN_OFFSET) >> (y & 7)) & 1;
+      if (ramBit != display.getPixel(x, y)) return false;
+    }
+  }
+  return true;
+}
+
+// begin(): init commands, every page cleared in full, display on
+static void checkBegin(MockDisplayBus& bus, DisplaySH1106& display) {
+  CHECK(display.begin());
+  const auto& transactions = bus.getTransactions();
+  CHECK(transactions.size() == 1 + 2 * SH1106_PAGES + 1);
+  CHECK(transactions.front().isCommand && transactions.front().bytes[0] == 0xAE);
+  for (int page = 0; page < SH1106_PAGES; ++page) {
+    CHECK(isAddress(bus, 1 + 2 * page, page, 0));
+    CHECK(isData(bus, 2 + 2 * page, SH1106_WIDTH, 0x00));
+  }
+  CHECK(transactions.back().isCommand && transactions.back().bytes == std::vector<uint8_t>{ 0xAF });
+  CHECK(bus.getDataBytes() == SH1106_PAGES * SH1106_WIDTH);
+}
+
+// Small changes: one address and one data transaction per changed page, covering only
+// the changed columns
+static void checkColumnRanges(MockDisplayBus& bus, DisplaySH1106& display) {
+  bus.clear();
+  display.drawPixel(10, 3, 1);        // Page 0, column 10, bit 3
+  display.fillRect(40, 20, 8, 4, 1);  // Page 2, columns 40..47, bits 4..7
+  display.display();
+  CHECK(bus.getTransactions().size() == 4);
+  CHECK(isAddress(bus, 0, 0, 10));
+  CHECK(isData(bus, 1, 1, 0x08));
+  CHECK(isAddress(bus, 2, 2, 40));
+  CHECK(isData(bus, 3, 8, 0xF0));
+  CHECK(ramMatches(bus, display));
+
+  // Nothing changed: nothing sent
+  bus.clear();
+  display.display();
+  CHECK(bus.getTransactions().empty());
+
+  // A rectangle across a page boundary changes the same columns of both pages
+  bus.clear();
+  display.drawPixel(10, 3, 2);       // Inverted back off
+  display.fillRect(0, 6, 3, 4, 1);   // Rows 6..9: page 0 bits 6..7, page 1 bits 0..1
+  display.display();
+  CHECK(bus.getTransactions().size() == 4);
+  CHECK(isAddress(bus, 0, 0, 0));
+  CHECK(bus.getTransactions()[1].bytes == (std::vector<uint8_t>{ 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+                                                                  0x00, 0x00, 0x00, 0x00 }));
+  CHECK(isAddress(bus, 2, 1, 0));
+  CHECK(isData(bus, 3, 3, 0x03));
+  CHECK(ramMatches(bus, display));
+}
+
+// A menu frame: the panel shows the frame buffer after render() and after update()
+static void checkMenuFrame(MockDisplayBus& bus, DisplaySH1106& display) {
+  MenuDisplay menu(display);
+  menu.setMenu({
+    MenuBuilder::createItem("WiFi"),
+    MenuBuilder::createItem("Bluetooth"),
+    MenuBuilder::createItem("Größe"),
+    MenuBuilder::createItem("About")
+  });
+
+  bus.clear();
+  menu.render();
+  CHECK(bus.getTransactions().size() == 2 * SH1106_PAGES);  // Cleared first: every page, in full
+  for (int page = 0; page < SH1106_PAGES; ++page) {
+    CHECK(isAddress(bus, 2 * page, page, 0));
+  }
+  CHECK(ramMatches(bus, display));
+
+  // Moving the selection repaints two rows and the scrollbar: less than a full frame
+  bus.clear();
+  menu.scrollDown();
+  menu.update();
+  const auto& transactions = bus.getTransactions();
+  CHECK(!transactions.empty() && transactions.size() % 2 == 0);
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    CHECK(transactions[i].isCommand == (i % 2 == 0));
+  }
+  CHECK(bus.getDataBytes() < SH1106_PAGES * SH1106_WIDTH);
+  CHECK(ramMatches(bus, display));
+}
+
+int main() {
+  MockDisplayBus bus;
+  DisplaySH1106 display(bus);
+
+  checkBegin(bus, display);
+  checkColumnRanges(bus, display);
+  checkMenuFrame(bus, display);
+
+  if (failures) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef TRACE_REPLAY_ARDUINO_H
+#define TRACE_REPLAY_ARDUINO_H
+
+// Minimal Arduino API for building the library on the host (see TraceReplay.cpp).
+// Time comes from a virtual clock set by the replay tool, so every run of a trace
+// sees exactly the same millis() and micros() values.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Virtual clock (ms) and the number of micros() calls since it was last set
+inline unsigned long& hostClock() {
+  static unsigned long clock = 0;
+  return clock;
+}
+
+inline unsigned long& hostMicrosTicks() {
+  static unsigned long ticks = 0;
+  return ticks;
+}
+
+// Moves the virtual clock to 'ms'
+inline void setHostClock(unsigned long ms) {
+  hostClock() = ms;
+  hostMicrosTicks() = 0;
+}
+
+inline unsigned long millis() {
+  return hostClock();
+}
+
+// Advances by 1 us per call, so time budgets (e.g. setTaskBudget) run out after the
+// same number of steps on every replay
+inline unsigned long micros() {
+  return hostClock() * 1000 + hostMicrosTicks()++;
+}
+
+inline void delay(unsigned long ms) {
+  setHostClock(hostClock() + ms);
+}
+
+inline void delayMicroseconds(unsigned int us) {
+  hostMicrosTicks() += us;
+}
+
+#endif // TRACE_REPLAY_ARDUINO_H
@@ -0,0 +1,44 @@
+#ifndef TRACE_MENU_H
+#define TRACE_MENU_H
+
+// The menu replayed by TraceReplay. Replace the contents of these functions with the
+// menu and status bar of the application that recorded the trace: the trace only
+// holds the inputs, so the tree must match for the replay to follow the same path.
+
+#include "MenuDisplay.h"
+#include "MenuBuilder.h"
+#include "PixelBattery.h"
+#include "PixelBle.h"
+#include "DisplaySH1106.h"
+
+using TraceMenu = MenuDisplay;
+
+static std::shared_ptr<PixelBattery> traceBattery;
+
+// Builds the menu and the status bar
+inline void buildTraceMenu(TraceMenu& menu) {
+  traceBattery = std::make_shared<PixelBattery>();
+  menu.addLeftElement(std::make_shared<PixelBle>());
+  menu.addRightElement(traceBattery);
+
+  menu.setMenu({
+    MenuBuilder::createMenu("Settings", {
+      MenuBuilder::createItem("WiFi"),
+      MenuBuilder::createItem("Bluetooth"),
+      MenuBuilder::createItem("Brightness"),
+      MenuBuilder::createItem("A rather long label that scrolls sideways")
+    }),
+    MenuBuilder::createItem("Devices"),
+    MenuBuilder::createItem("Logs"),
+    MenuBuilder::createItem("Info"),
+    MenuBuilder::createItem("About"),
+    MenuBuilder::createItem("Restart")
+  });
+}
+
+// Applies a status change recorded with traceStatus(element, value)
+inline void applyTraceStatus(uint8_t element, int32_t value) {
+  if (element == 0) traceBattery->setLevel(value);  // Battery level
+}
+
+#endif // TRACE_MENU_H
@@ -0,0 +1,149 @@
+// Replays an input trace recorded with MenuDisplay::setInputTrace() on the host.
+//
+// The menu from TraceMenu.h is driven through the same calls at the same (virtual)
+// times as on the device and drawn by DisplaySH1106 into a MockDisplayBus. For every
+// frame it prints the host time spent in update()/render(), the bytes sent to the
+// panel and a hash of the frame buffer; the same trace always gives the same bytes
+// and hashes, so a trace from the field becomes a repeatable performance test.
+//
+// Build from this directory (the local Arduino.h replaces the Arduino core):
+//   g++ -std=c++17 -O2 -I. -I../../src TraceReplay.cpp ../../src/*.cpp -o trace-replay
+// Run:
+//   ./trace-replay trace.bin          one line per frame, then a summary
+//   ./trace-replay -q trace.bin       summary only
+
+#include "Arduino.h"
+#include "TraceMenu.h"
+#include "InputTrace.h"
+#include "DisplayBus.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// FNV-1a over the frame buffer
+static uint32_t hashFrame(const uint8_t* data, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// Names of the TraceEvent values, for the frame lines
+static const char* const EVENT_NAMES[] = {
+  "up", "down", "left", "right", "select", "back", "pageUp", "pageDown",
+  "home", "end", "jump", "move", "invalidate", "status", "update", "render"
+};
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+  FILE* file = fopen(path, "rb");
+  if (!file) return false;
+  uint8_t chunk[512];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  bool quiet = false;
+  const char* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-q") == 0) {
+      quiet = true;
+    } else {
+      path = argv[i];
+    }
+  }
+  if (!path) {
+    fprintf(stderr, "usage: %s [-q] trace.bin\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<uint8_t> data;
+  if (!readFile(path, data)) {
+    fprintf(stderr, "cannot read %s\n", path);
+    return 2;
+  }
+  InputTraceReader reader(data.data(), data.size());
+  if (!reader.isValid()) {
+    fprintf(stderr, "%s is not a MenuDisplay input trace (version %d)\n", path, InputTraceRecorder::VERSION);
+    return 1;
+  }
+
+  MockDisplayBus bus;
+  DisplaySH1106 display(bus);
+  TraceMenu menu(display);
+  display.begin();
+  buildTraceMenu(menu);
+  bus.clear();
+
+  unsigned long frames = 0, totalBytes = 0, totalMicros = 0, maxMicros = 0;
+  uint32_t traceHash = 2166136261u;  // Hash of all frame hashes
+  TraceRecord record;
+
+  if (!quiet) printf("frame\ttime_ms\tevent\trender_us\tbytes\thash\n");
+  while (reader.next(record)) {
+    setHostClock(record.time);
+    switch (record.event) {
+      case TraceEvent::UP:         menu.scrollUp(); break;
+      case TraceEvent::DOWN:       menu.scrollDown(); break;
+      case TraceEvent::LEFT:       menu.scrollLeft(); break;
+      case TraceEvent::RIGHT:      menu.scrollRight(); break;
+      case TraceEvent::SELECT:     menu.select(); break;
+      case TraceEvent::BACK:       menu.goBack(); break;
+      case TraceEvent::PAGE_UP:    menu.pageUp(); break;
+      case TraceEvent::PAGE_DOWN:  menu.pageDown(); break;
+      case TraceEvent::HOME:       menu.home(); break;
+      case TraceEvent::END:        menu.end(); break;
+      case TraceEvent::JUMP:       menu.jumpTo(record.value); break;
+      case TraceEvent::MOVE:       menu.moveBy(record.value); break;
+      case TraceEvent::INVALIDATE: menu.invalidate(); break;
+      case TraceEvent::STATUS:     applyTraceStatus(record.element, record.value); break;
+      case TraceEvent::NAVIGATE:
+        if (record.path[0]) {
+          menu.navigateTo(record.path, record.element != 0);
+        } else {
+          menu.navigateTo((MenuPathId)record.value, record.element != 0);
+        }
+        break;
+      case TraceEvent::UPDATE:
+      case TraceEvent::RENDER: {
+        const auto start = std::chrono::steady_clock::now();
+        if (record.event == TraceEvent::UPDATE) {
+          menu.update();
+        } else {
+          menu.render();
+        }
+        const unsigned long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start).count();
+
+        unsigned long bytes = 0;
+        for (const auto& transaction : bus.getTransactions()) {
+          bytes += transaction.bytes.size();
+        }
+        bus.clear();
+        const uint32_t hash = hashFrame(display.getBuffer(), SH1106_PAGES * SH1106_WIDTH);
+        traceHash = (traceHash ^ hash) * 16777619u;
+
+        ++frames;
+        totalBytes += bytes;
+        totalMicros += elapsed;
+        if (elapsed > maxMicros) maxMicros = elapsed;
+        if (!quiet) {
+          printf("%lu\t%lu\t%s\t%lu\t%lu\t%08lx\n", frames, record.time, EVENT_NAMES[(int)record.event],
+                 elapsed, bytes, (unsigned long)hash);
+        }
+        break;
+      }
+    }
+  }
+
+  printf("frames %lu, render avg %lu us, max %lu us, bytes %lu (avg %lu), trace hash %08lx\n",
+         frames, frames ? totalMicros / frames : 0, maxMicros, totalBytes,
+         frames ? totalBytes / frames : 0, (unsigned long)traceHash);
+  return reader.isValid() ? 0 : 1;  // Non-zero if the trace ended in corrupt data
+}
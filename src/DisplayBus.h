@@ -0,0 +1,193 @@
+#ifndef DISPLAY_BUS_H
+#define DISPLAY_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Transport between a display driver (see DisplaySH1106) and the controller.
+// Each call is sent as one batched transaction: one I2C write sequence or one SPI
+// chip-select period, instead of one per byte.
+class DisplayBus {
+public:
+  virtual ~DisplayBus() = default;
+
+  // Prepares the bus; returns false if the controller does not respond
+  virtual bool begin() { return true; }
+
+  // Sends 'length' command bytes
+  virtual void sendCommands(const uint8_t* commands, size_t length) = 0;
+
+  // Sends 'length' bytes of display RAM data
+  virtual void sendData(const uint8_t* data, size_t length) = 0;
+};
+
+#if defined(ARDUINO)
+#include <Wire.h>
+#include <SPI.h>
+
+// Largest I2C write per transmission (the Wire buffer holds the control byte too)
+#ifndef DISPLAY_BUS_I2C_CHUNK
+#if defined(ARDUINO_ARCH_AVR)
+#define DISPLAY_BUS_I2C_CHUNK 31
+#else
+#define DISPLAY_BUS_I2C_CHUNK 127
+#endif
+#endif
+
+// I2C transport: a control byte (0x00 = commands, 0x40 = data) followed by as many
+// bytes as the Wire buffer allows per transmission
+class I2CDisplayBus : public DisplayBus {
+private:
+  TwoWire& wire;    // I2C port
+  uint8_t address;  // 7-bit controller address
+  uint32_t clock;   // Bus clock (Hz)
+
+  // Sends 'length' bytes in chunks, each prefixed with 'control'
+  void send(uint8_t control, const uint8_t* bytes, size_t length) {
+    while (length > 0) {
+      size_t chunk = length < DISPLAY_BUS_I2C_CHUNK ? length : DISPLAY_BUS_I2C_CHUNK;
+      wire.beginTransmission(address);
+      wire.write(control);
+      wire.write(bytes, chunk);
+      wire.endTransmission();
+      bytes += chunk;
+      length -= chunk;
+    }
+  }
+
+public:
+  I2CDisplayBus(uint8_t address = 0x3C, TwoWire& wire = Wire, uint32_t clock = 400000)
+    : wire(wire), address(address), clock(clock) {}
+
+  bool begin() override {
+    wire.begin();
+    wire.setClock(clock);
+    wire.beginTransmission(address);
+    return wire.endTransmission() == 0;  // Controller acknowledged its address
+  }
+
+  void sendCommands(const uint8_t* commands, size_t length) override {
+    send(0x00, commands, length);
+  }
+
+  void sendData(const uint8_t* data, size_t length) override {
+    send(0x40, data, length);
+  }
+};
+
+// 4-wire SPI transport: the D/C pin selects commands (low) or data (high)
+class SPIDisplayBus : public DisplayBus {
+private:
+  SPIClass& spi;          // SPI port
+  int8_t csPin;           // Chip select, active low
+  int8_t dcPin;           // Data/command select
+  SPISettings settings;   // Clock, bit order and mode
+
+  // Sends 'length' bytes in one chip-select period with D/C at 'dc'
+  void send(uint8_t dc, const uint8_t* bytes, size_t length) {
+    spi.beginTransaction(settings);
+    digitalWrite(dcPin, dc);
+    digitalWrite(csPin, LOW);
+    for (size_t i = 0; i < length; ++i) {
+      spi.transfer(bytes[i]);
+    }
+    digitalWrite(csPin, HIGH);
+    spi.endTransaction();
+  }
+
+public:
+  SPIDisplayBus(int8_t csPin, int8_t dcPin, uint32_t frequency = 8000000, SPIClass& spi = SPI)
+    : spi(spi), csPin(csPin), dcPin(dcPin), settings(frequency, MSBFIRST, SPI_MODE0) {}
+
+  bool begin() override {
+    pinMode(csPin, OUTPUT);
+    pinMode(dcPin, OUTPUT);
+    digitalWrite(csPin, HIGH);
+    spi.begin();
+    return true;  // SPI has no acknowledge
+  }
+
+  void sendCommands(const uint8_t* commands, size_t length) override {
+    send(LOW, commands, length);
+  }
+
+  void sendData(const uint8_t* data, size_t length) override {
+    send(HIGH, data, length);
+  }
+};
+#endif
+
+#if !defined(ARDUINO)
+#include <vector>
+#include <string.h>
+
+// One call to the bus recorded by MockDisplayBus
+struct BusTransaction {
+  bool isCommand;              // sendCommands() (true) or sendData() (false)
+  std::vector<uint8_t> bytes;  // Bytes sent
+};
+
+// Host bus that records every transaction and models the SH1106 display RAM
+// (page and column addressing), so tests can check what reached the panel.
+class MockDisplayBus : public DisplayBus {
+private:
+  std::vector<BusTransaction> transactions;  // Recorded calls, oldest first
+  size_t dataBytes = 0;                      // RAM data bytes sent since clear()
+  uint8_t ram[8][132] = {};                  // Controller RAM, 132 columns per page
+  int page = 0;                              // Page address of the next data byte
+  int column = 0;                            // Column address of the next data byte
+
+  // Number of argument bytes following an SH1106 command
+  static int argumentCount(uint8_t command) {
+    switch (command) {
+      case 0x81: case 0xA8: case 0xAD: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+      default:
+        return 0;
+    }
+  }
+
+public:
+  void sendCommands(const uint8_t* commands, size_t length) override {
+    transactions.push_back(BusTransaction{true, std::vector<uint8_t>(commands, commands + length)});
+    for (size_t i = 0; i < length; ++i) {
+      const uint8_t command = commands[i];
+      if (command <= 0x0F) {
+        column = (column & 0xF0) | command;                // Lower column address
+      } else if (command <= 0x1F) {
+        column = (column & 0x0F) | ((command & 0x0F) << 4);  // Higher column address
+      } else if ((command & 0xF8) == 0xB0) {
+        page = command & 0x07;                             // Page address
+      } else {
+        i += argumentCount(command);
+      }
+    }
+  }
+
+  void sendData(const uint8_t* data, size_t length) override {
+    transactions.push_back(BusTransaction{false, std::vector<uint8_t>(data, data + length)});
+    dataBytes += length;
+    for (size_t i = 0; i < length; ++i) {
+      if (column < 132) ram[page][column] = data[i];
+      ++column;
+    }
+  }
+
+  // Recorded transactions, oldest first
+  const std::vector<BusTransaction>& getTransactions() const { return transactions; }
+
+  // RAM data bytes sent since the last clear()
+  size_t getDataBytes() const { return dataBytes; }
+
+  // Byte of the modelled controller RAM (column 0..131, page 0..7)
+  uint8_t getRam(int ramPage, int ramColumn) const { return ram[ramPage][ramColumn]; }
+
+  // Forgets the recorded transactions (the RAM model is kept)
+  void clear() {
+    transactions.clear();
+    dataBytes = 0;
+  }
+};
+#endif
+
+#endif // DISPLAY_BUS_H
@@ -1,6 +1,8 @@
 #ifndef DISPLAY_INTERFACE_H
 #define DISPLAY_INTERFACE_H
 
+#include <stdint.h>
+
 // Abstract interface for display functionality
 // This allows different types of displays to be used interchangeably
 class DisplayInterface {
@@ -59,7 +61,29 @@ public:
                           int x2, int y2,
                           int color) = 0;
 
-
+  // Draws a 'w' x 'h' bitmap stored in pages of 8 rows: byte i of page p holds column i,
+  // rows 8p..8p+7, LSB on top (the layout of the SH1106 RAM and of the 5x7 font).
+  // Set bits are drawn in 'color', clear bits leave the screen unchanged.
+  // Drivers with a page-major buffer override this with byte-wise copies.
+  virtual void drawBitmap(int x, int y, const uint8_t* bitmap, int w, int h, int color) {
+    for (int row = 0; row < h; ++row) {
+      const uint8_t* page = bitmap + (row / 8) * w;
+      const uint8_t bit = 1 << (row % 8);
+      for (int col = 0; col < w; ++col) {
+        if (page[col] & bit) drawPixel(x + col, y + row, color);
+      }
+    }
+  }
+
+  // Sets the display contrast/brightness (0-255). Optional, used for idle dimming.
+  virtual void setContrast(uint8_t contrast) {}
+
+  // Returns the color of the pixel at (x, y) in the display buffer, or -1 if the
+  // display cannot read its buffer. Optional, used to save the pixels under overlays.
+  virtual int getPixel(int x, int y) { return -1; }
+
+  // Switches the display panel on or off, keeping its contents. Optional, used for idle sleep.
+  virtual void setPower(bool on) {}
 };
 
 #endif // DISPLAY_INTERFACE_H
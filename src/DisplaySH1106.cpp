@@ -0,0 +1,387 @@
+#include "DisplaySH1106.h"
+#include <string.h>
+#include <stdio.h>   // For vsnprintf
+#include <stdarg.h>  // For va_list, va_start, va_end
+
+// 5x7 font, characters 0x20..0x7E. Each glyph is 5 column bytes, bit 0 = top row,
+// bit 7 = descender row; the sixth column of a character cell is spacing.
+const uint8_t DisplaySH1106::FONT[95][5] PROGMEM = {
+  { 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+  { 0x00, 0x00, 0x5F, 0x00, 0x00 },  // !
+  { 0x00, 0x07, 0x00, 0x07, 0x00 },  // "
+  { 0x14, 0x7F, 0x14, 0x7F, 0x14 },  // #
+  { 0x24, 0x2A, 0x7F, 0x2A, 0x12 },  // $
+  { 0x23, 0x13, 0x08, 0x64, 0x62 },  // %
+  { 0x36, 0x49, 0x56, 0x20, 0x50 },  // &
+  { 0x00, 0x08, 0x07, 0x03, 0x00 },  // '
+  { 0x00, 0x1C, 0x22, 0x41, 0x00 },  // (
+  { 0x00, 0x41, 0x22, 0x1C, 0x00 },  // )
+  { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A },  // *
+  { 0x08, 0x08, 0x3E, 0x08, 0x08 },  // +
+  { 0x00, 0x80, 0x70, 0x30, 0x00 },  // ,
+  { 0x08, 0x08, 0x08, 0x08, 0x08 },  // -
+  { 0x00, 0x00, 0x60, 0x60, 0x00 },  // .
+  { 0x20, 0x10, 0x08, 0x04, 0x02 },  // /
+  { 0x3E, 0x51, 0x49, 0x45, 0x3E },  // 0
+  { 0x00, 0x42, 0x7F, 0x40, 0x00 },  // 1
+  { 0x72, 0x49, 0x49, 0x49, 0x46 },  // 2
+  { 0x21, 0x41, 0x49, 0x4D, 0x33 },  // 3
+  { 0x18, 0x14, 0x12, 0x7F, 0x10 },  // 4
+  { 0x27, 0x45, 0x45, 0x45, 0x39 },  // 5
+  { 0x3C, 0x4A, 0x49, 0x49, 0x31 },  // 6
+  { 0x41, 0x21, 0x11, 0x09, 0x07 },  // 7
+  { 0x36, 0x49, 0x49, 0x49, 0x36 },  // 8
+  { 0x46, 0x49, 0x49, 0x29, 0x1E },  // 9
+  { 0x00, 0x00, 0x14, 0x00, 0x00 },  // :
+  { 0x00, 0x40, 0x34, 0x00, 0x00 },  // ;
+  { 0x00, 0x08, 0x14, 0x22, 0x41 },  // <
+  { 0x14, 0x14, 0x14, 0x14, 0x14 },  // =
+  { 0x00, 0x41, 0x22, 0x14, 0x08 },  // >
+  { 0x02, 0x01, 0x59, 0x09, 0x06 },  // ?
+  { 0x3E, 0x41, 0x5D, 0x59, 0x4E },  // @
+  { 0x7C, 0x12, 0x11, 0x12, 0x7C },  // A
+  { 0x7F, 0x49, 0x49, 0x49, 0x36 },  // B
+  { 0x3E, 0x41, 0x41, 0x41, 0x22 },  // C
+  { 0x7F, 0x41, 0x41, 0x41, 0x3E },  // D
+  { 0x7F, 0x49, 0x49, 0x49, 0x41 },  // E
+  { 0x7F, 0x09, 0x09, 0x09, 0x01 },  // F
+  { 0x3E, 0x41, 0x41, 0x51, 0x73 },  // G
+  { 0x7F, 0x08, 0x08, 0x08, 0x7F },  // H
+  { 0x00, 0x41, 0x7F, 0x41, 0x00 },  // I
+  { 0x20, 0x40, 0x41, 0x3F, 0x01 },  // J
+  { 0x7F, 0x08, 0x14, 0x22, 0x41 },  // K
+  { 0x7F, 0x40, 0x40, 0x40, 0x40 },  // L
+  { 0x7F, 0x02, 0x1C, 0x02, 0x7F },  // M
+  { 0x7F, 0x04, 0x08, 0x10, 0x7F },  // N
+  { 0x3E, 0x41, 0x41, 0x41, 0x3E },  // O
+  { 0x7F, 0x09, 0x09, 0x09, 0x06 },  // P
+  { 0x3E, 0x41, 0x51, 0x21, 0x5E },  // Q
+  { 0x7F, 0x09, 0x19, 0x29, 0x46 },  // R
+  { 0x26, 0x49, 0x49, 0x49, 0x32 },  // S
+  { 0x03, 0x01, 0x7F, 0x01, 0x03 },  // T
+  { 0x3F, 0x40, 0x40, 0x40, 0x3F },  // U
+  { 0x1F, 0x20, 0x40, 0x20, 0x1F },  // V
+  { 0x3F, 0x40, 0x38, 0x40, 0x3F },  // W
+  { 0x63, 0x14, 0x08, 0x14, 0x63 },  // X
+  { 0x03, 0x04, 0x78, 0x04, 0x03 },  // Y
+  { 0x61, 0x59, 0x49, 0x4D, 0x43 },  // Z
+  { 0x00, 0x7F, 0x41, 0x41, 0x41 },  // [
+  { 0x02, 0x04, 0x08, 0x10, 0x20 },  // backslash
+  { 0x00, 0x41, 0x41, 0x41, 0x7F },  // ]
+  { 0x04, 0x02, 0x01, 0x02, 0x04 },  // ^
+  { 0x40, 0x40, 0x40, 0x40, 0x40 },  // _
+  { 0x00, 0x03, 0x07, 0x08, 0x00 },  // `
+  { 0x20, 0x54, 0x54, 0x78, 0x40 },  // a
+  { 0x7F, 0x28, 0x44, 0x44, 0x38 },  // b
+  { 0x38, 0x44, 0x44, 0x44, 0x28 },  // c
+  { 0x38, 0x44, 0x44, 0x28, 0x7F },  // d
+  { 0x38, 0x54, 0x54, 0x54, 0x18 },  // e
+  { 0x00, 0x08, 0x7E, 0x09, 0x02 },  // f
+  { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },  // g
+  { 0x7F, 0x08, 0x04, 0x04, 0x78 },  // h
+  { 0x00, 0x44, 0x7D, 0x40, 0x00 },  // i
+  { 0x20, 0x40, 0x40, 0x3D, 0x00 },  // j
+  { 0x7F, 0x10, 0x28, 0x44, 0x00 },  // k
+  { 0x00, 0x41, 0x7F, 0x40, 0x00 },  // l
+  { 0x7C, 0x04, 0x78, 0x04, 0x78 },  // m
+  { 0x7C, 0x08, 0x04, 0x04, 0x78 },  // n
+  { 0x38, 0x44, 0x44, 0x44, 0x38 },  // o
+  { 0xFC, 0x18, 0x24, 0x24, 0x18 },  // p
+  { 0x18, 0x24, 0x24, 0x18, 0xFC },  // q
+  { 0x7C, 0x08, 0x04, 0x04, 0x08 },  // r
+  { 0x48, 0x54, 0x54, 0x54, 0x24 },  // s
+  { 0x04, 0x04, 0x3F, 0x44, 0x24 },  // t
+  { 0x3C, 0x40, 0x40, 0x20, 0x7C },  // u
+  { 0x1C, 0x20, 0x40, 0x20, 0x1C },  // v
+  { 0x3C, 0x40, 0x30, 0x40, 0x3C },  // w
+  { 0x44, 0x28, 0x10, 0x28, 0x44 },  // x
+  { 0x4C, 0x90, 0x90, 0x90, 0x7C },  // y
+  { 0x44, 0x64, 0x54, 0x4C, 0x44 },  // z
+  { 0x00, 0x08, 0x36, 0x41, 0x00 },  // {
+  { 0x00, 0x00, 0x77, 0x00, 0x00 },  // |
+  { 0x00, 0x41, 0x36, 0x08, 0x00 },  // }
+  { 0x02, 0x01, 0x02, 0x04, 0x02 },  // ~
+};
+
+// Controller setup for a 128x64 SH1106 panel
+static const uint8_t INIT_COMMANDS[] = {
+  0xAE,        // Display off
+  0xD5, 0x80,  // Clock divide ratio / oscillator frequency
+  0xA8, 0x3F,  // Multiplex ratio: 64 rows
+  0xD3, 0x00,  // No display offset
+  0x40,        // Start line 0
+  0xAD, 0x8B,  // Internal DC-DC converter on
+  0xA1,        // Segment remap
+  0xC8,        // COM scan direction remapped
+  0xDA, 0x12,  // COM pins: alternative configuration
+  0x81, 0x7F,  // Contrast
+  0xD9, 0x22,  // Pre-charge period
+  0xDB, 0x35,  // VCOM deselect level
+  0xA4,        // Output follows RAM
+  0xA6,        // Normal (not inverted) display
+};
+
+// Combines 'bits' into a buffer byte: 0 = clear, 1 = set, 2 = invert
+static inline void blend(uint8_t& target, uint8_t bits, int color) {
+  if (color == 0) {
+    target &= ~bits;
+  } else if (color == 1) {
+    target |= bits;
+  } else {
+    target ^= bits;
+  }
+}
+
+DisplaySH1106::DisplaySH1106(DisplayBus& bus) : bus(bus) {
+  memset(dirtyFirst, 0, sizeof(dirtyFirst));  // Nothing sent yet: every column is changed
+  memset(dirtyLast, SH1106_WIDTH - 1, sizeof(dirtyLast));
+}
+
+bool DisplaySH1106::begin() {
+  if (!bus.begin()) return false;
+  bus.sendCommands(INIT_COMMANDS, sizeof(INIT_COMMANDS));
+  clearDisplay();
+  display();  // Controller RAM is random after power-up
+  setPower(true);
+  return true;
+}
+
+// ========== BUFFER HELPERS ==========
+
+void DisplaySH1106::markDirty(int page, int first, int last) {
+  if (first < dirtyFirst[page]) dirtyFirst[page] = first;
+  if (last > dirtyLast[page]) dirtyLast[page] = last;
+}
+
+// Applies 'mask' to 'w' columns of 'page' starting at 'x' (already clipped)
+void DisplaySH1106::applyMask(int page, int x, int w, uint8_t mask, int color) {
+  uint8_t* column = &buffer[page][x];
+  if (mask == 0xFF && color != 2) {
+    memset(column, color ? 0xFF : 0x00, w);  // Whole bytes: plain fill
+  } else {
+    for (uint8_t* end = column + w; column < end; ++column) {
+      blend(*column, mask, color);
+    }
+  }
+  markDirty(page, x, x + w - 1);
+}
+
+// ========== DRAWING ==========
+
+void DisplaySH1106::drawPixel(int x, int y, int color) {
+  if (x < 0 || x >= SH1106_WIDTH || y < 0 || y >= SH1106_HEIGHT) return;
+  blend(buffer[y >> 3][x], 1 << (y & 7), color);
+  markDirty(y >> 3, x, x);
+}
+
+void DisplaySH1106::drawFastHLine(int x, int y, int w, int color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void DisplaySH1106::drawFastVLine(int x, int y, int h, int color) {
+  fillRect(x, y, 1, h, color);
+}
+
+// Fills the rectangle page by page: partial top and bottom pages get a row mask,
+// pages in between are filled with whole bytes
+void DisplaySH1106::fillRect(int x, int y, int w, int h, int color) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > SH1106_WIDTH) w = SH1106_WIDTH - x;
+  if (y + h > SH1106_HEIGHT) h = SH1106_HEIGHT - y;
+  if (w <= 0 || h <= 0) return;
+
+  const int firstPage = y >> 3;
+  const int lastPage = (y + h - 1) >> 3;
+  for (int page = firstPage; page <= lastPage; ++page) {
+    uint8_t mask = 0xFF;
+    if (page == firstPage) mask &= 0xFF << (y & 7);
+    if (page == lastPage) mask &= 0xFF >> (7 - ((y + h - 1) & 7));
+    applyMask(page, x, w, mask, color);
+  }
+}
+
+// Copies the bitmap a byte at a time. At a y that is a multiple of 8 every source
+// byte lands in one buffer byte; otherwise it is split across two pages.
+void DisplaySH1106::drawBitmap(int x, int y, const uint8_t* bitmap, int w, int h, int color) {
+  const int firstColumn = x < 0 ? -x : 0;
+  const int endColumn = (x + w > SH1106_WIDTH) ? SH1106_WIDTH - x : w;
+  if (h <= 0 || firstColumn >= endColumn) return;
+
+  const int shift = y & 7;  // Row inside the first destination page
+  const int sourcePages = (h + 7) >> 3;
+  for (int sourcePage = 0; sourcePage < sourcePages; ++sourcePage) {
+    const int page = (y >> 3) + sourcePage;
+    const bool upper = (page >= 0 && page < SH1106_PAGES);
+    const bool lower = (shift != 0 && page + 1 >= 0 && page + 1 < SH1106_PAGES);
+    if (!upper && !lower) continue;
+
+    // Rows of the last source page below 'h' are not part of the bitmap
+    const uint8_t valid = (sourcePage == sourcePages - 1 && (h & 7)) ? (0xFF >> (8 - (h & 7))) : 0xFF;
+    const uint8_t* source = bitmap + sourcePage * w;
+    for (int col = firstColumn; col < endColumn; ++col) {
+      const uint8_t bits = source[col] & valid;
+      if (!bits) continue;
+      if (upper) blend(buffer[page][x + col], bits << shift, color);
+      if (lower) blend(buffer[page + 1][x + col], bits >> (8 - shift), color);
+    }
+    if (upper) markDirty(page, x + firstColumn, x + endColumn - 1);
+    if (lower) markDirty(page + 1, x + firstColumn, x + endColumn - 1);
+  }
+}
+
+void DisplaySH1106::drawLine(int x0, int y0, int x1, int y1, int color) {
+  if (y0 == y1) {
+    drawFastHLine(x0 < x1 ? x0 : x1, y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, color);
+    return;
+  }
+  if (x0 == x1) {
+    drawFastVLine(x0, y0 < y1 ? y0 : y1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, color);
+    return;
+  }
+
+  const int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  const int dy = -(y1 > y0 ? y1 - y0 : y0 - y1);
+  const int stepX = x0 < x1 ? 1 : -1;
+  const int stepY = y0 < y1 ? 1 : -1;
+  int error = dx + dy;
+  while (true) {
+    drawPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) break;
+    const int error2 = 2 * error;
+    if (error2 >= dy) { error += dy; x0 += stepX; }
+    if (error2 <= dx) { error += dx; y0 += stepY; }
+  }
+}
+
+void DisplaySH1106::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, int color) {
+  drawLine(x0, y0, x1, y1, color);
+  drawLine(x1, y1, x2, y2, color);
+  drawLine(x2, y2, x0, y0, color);
+}
+
+// Fills the triangle with one horizontal span per row
+void DisplaySH1106::fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, int color) {
+  // Sort the corners by y (y0 <= y1 <= y2)
+  if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+  if (y1 > y2) { int t = y1; y1 = y2; y2 = t; t = x1; x1 = x2; x2 = t; }
+  if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+
+  if (y0 == y2) {  // All corners on one row
+    int left = x0 < x1 ? x0 : x1;
+    int right = x0 > x1 ? x0 : x1;
+    if (x2 < left) left = x2;
+    if (x2 > right) right = x2;
+    drawFastHLine(left, y0, right - left + 1, color);
+    return;
+  }
+
+  for (int y = y0; y <= y2; ++y) {
+    int a = x0 + (x2 - x0) * (y - y0) / (y2 - y0);  // Long edge
+    int b;
+    if (y < y1) {
+      b = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
+    } else if (y1 == y2) {
+      b = x1;
+    } else {
+      b = x1 + (x2 - x1) * (y - y1) / (y2 - y1);
+    }
+    if (a > b) { int t = a; a = b; b = t; }
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+}
+
+int DisplaySH1106::getPixel(int x, int y) {
+  if (x < 0 || x >= SH1106_WIDTH || y < 0 || y >= SH1106_HEIGHT) return 0;
+  return (buffer[y >> 3][x] >> (y & 7)) & 1;
+}
+
+// ========== TEXT ==========
+
+// Draws a character cell's glyph; only the set font pixels are drawn
+void DisplaySH1106::drawChar(int x, int y, char c) {
+  uint8_t glyph[5];  // The font is in flash
+  memcpy_P(glyph, FONT[(c >= 0x20 && c <= 0x7E) ? c - 0x20 : '?' - 0x20], sizeof(glyph));
+  if (textSize == 1) {
+    drawBitmap(x, y, glyph, 5, 8, textColor);
+    return;
+  }
+  for (int col = 0; col < 5; ++col) {
+    uint8_t bits = glyph[col];
+    for (int row = 0; bits; ++row, bits >>= 1) {
+      if (bits & 1) fillRect(x + col * textSize, y + row * textSize, textSize, textSize, textColor);
+    }
+  }
+}
+
+void DisplaySH1106::print(const char* text) {
+  const int cellWidth = 6 * textSize;
+  const int cellHeight = 8 * textSize;
+  for (; *text; ++text) {
+    if (*text == '\n') {
+      cursorX = 0;
+      cursorY += cellHeight;
+      continue;
+    }
+    if (*text == '\r') continue;
+    if (textWrap && cursorX + cellWidth > SH1106_WIDTH) {
+      cursorX = 0;
+      cursorY += cellHeight;
+    }
+    drawChar(cursorX, cursorY, *text);
+    cursorX += cellWidth;
+  }
+}
+
+void DisplaySH1106::println(const char* text) {
+  print(text);
+  cursorX = 0;
+  cursorY += 8 * textSize;
+}
+
+void DisplaySH1106::printf(const char* format, ...) {
+  char text[128];  // Temporary buffer for formatted text
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  print(text);
+}
+
+// ========== BUFFER AND PANEL ==========
+
+void DisplaySH1106::clearDisplay() {
+  memset(buffer, 0, sizeof(buffer));
+  memset(dirtyFirst, 0, sizeof(dirtyFirst));
+  memset(dirtyLast, SH1106_WIDTH - 1, sizeof(dirtyLast));
+}
+
+// Sends each page's changed column range as one command and one data transaction.
+// The SH1106 has no horizontal addressing mode, so pages are addressed one by one.
+void DisplaySH1106::display() {
+  for (int page = 0; page < SH1106_PAGES; ++page) {
+    if (dirtyFirst[page] > dirtyLast[page]) continue;
+
+    const int column = dirtyFirst[page] + SH1106_COLUMN_OFFSET;
+    const uint8_t commands[] = {
+      (uint8_t)(0xB0 | page),           // Page address
+      (uint8_t)(column & 0x0F),         // Column address, low nibble
+      (uint8_t)(0x10 | (column >> 4)),  // Column address, high nibble
+    };
+    bus.sendCommands(commands, sizeof(commands));
+    bus.sendData(&buffer[page][dirtyFirst[page]], dirtyLast[page] - dirtyFirst[page] + 1);
+
+    dirtyFirst[page] = 0xFF;  // Clean
+    dirtyLast[page] = 0;
+  }
+}
+
+void DisplaySH1106::setContrast(uint8_t contrast) {
+  const uint8_t commands[] = { 0x81, contrast };
+  bus.sendCommands(commands, sizeof(commands));
+}
+
+void DisplaySH1106::setPower(bool on) {
+  const uint8_t command = on ? 0xAF : 0xAE;
+  bus.sendCommands(&command, 1);
+}
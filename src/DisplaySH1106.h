@@ -0,0 +1,85 @@
+#ifndef DISPLAY_SH1106_H
+#define DISPLAY_SH1106_H
+
+#include "DisplayInterface.h"
+#include "DisplayBus.h"
+#include "MenuProgmem.h"
+
+// Panel size handled by DisplaySH1106 (the controller has 132 columns, 128 are visible)
+#define SH1106_WIDTH 128
+#define SH1106_HEIGHT 64
+#define SH1106_PAGES (SH1106_HEIGHT / 8)
+#define SH1106_COLUMN_OFFSET 2  // First visible controller column
+
+// Native SH1106 driver for 128x64 panels, without Adafruit GFX.
+// Draws into its own page-major buffer (one byte = 8 vertical pixels, LSB on top, the
+// layout of the controller RAM): spans and rectangles are filled with one mask per page
+// and column, bitmaps are copied a byte at a time. display() sends only the changed
+// columns of each page through a DisplayBus (I2C, SPI, or MockDisplayBus on the host).
+// Colors: 0 = off, 1 = on, 2 = invert. Declared final: calls made through a DisplaySH1106
+// reference (e.g. its own drawing helpers) need no virtual dispatch.
+class DisplaySH1106 final : public DisplayInterface {
+private:
+  DisplayBus& bus;                                  // Transport to the controller
+  uint8_t buffer[SH1106_PAGES][SH1106_WIDTH] = {};  // Frame buffer (1 KB)
+  uint8_t dirtyFirst[SH1106_PAGES];                 // First changed column of each page
+  uint8_t dirtyLast[SH1106_PAGES];                  // Last changed column (< first = unchanged)
+
+  // Text state
+  int cursorX = 0;       // Position of the next character
+  int cursorY = 0;
+  int textColor = 1;     // Color of set font pixels (the background is left unchanged)
+  int textSize = 1;      // Scale factor of the 5x7 font
+  bool textWrap = true;  // Continue on the next line at the right edge
+
+  // 5x7 font for characters 0x20..0x7E, 5 columns each, LSB on top (in flash)
+  static const uint8_t FONT[95][5];
+
+  void markDirty(int page, int first, int last);                // Extend the changed columns of 'page'
+  void applyMask(int page, int x, int w, uint8_t mask, int color);  // Set/clear/invert 'mask' in a page span
+  void drawChar(int x, int y, char c);                          // Draw one character at (x, y)
+  void drawLine(int x0, int y0, int x1, int y1, int color);     // Bresenham line
+
+public:
+  explicit DisplaySH1106(DisplayBus& bus);
+
+  // Initializes the bus and the controller and clears the screen; returns false if
+  // the controller does not respond
+  bool begin();
+
+  // Drawing
+  void drawPixel(int x, int y, int color) override;
+  void drawFastHLine(int x, int y, int w, int color) override;
+  void drawFastVLine(int x, int y, int h, int color);
+  void fillRect(int x, int y, int w, int h, int color) override;
+  void drawBitmap(int x, int y, const uint8_t* bitmap, int w, int h, int color) override;
+  void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, int color) override;
+  void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, int color) override;
+  int getPixel(int x, int y) override;
+
+  // Text
+  void setTextWrap(bool wrap) override { textWrap = wrap; }
+  void setTextColor(int color) override { textColor = color; }
+  void setTextSize(int size) override { textSize = size > 0 ? size : 1; }
+  void setCursor(int x, int y) override {
+    cursorX = x;
+    cursorY = y;
+  }
+  void print(const char* text) override;
+  void println(const char* text) override;
+  void printf(const char* format, ...) override;
+
+  int width() const override { return SH1106_WIDTH; }
+  int height() const override { return SH1106_HEIGHT; }
+
+  // Buffer and panel
+  void clearDisplay() override;
+  void display() override;  // Send the changed columns of each page
+  void setContrast(uint8_t contrast) override;
+  void setPower(bool on) override;
+
+  // Frame buffer, page-major (SH1106_PAGES rows of SH1106_WIDTH bytes)
+  const uint8_t* getBuffer() const { return &buffer[0][0]; }
+};
+
+#endif // DISPLAY_SH1106_H
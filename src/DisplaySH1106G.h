@@ -1,9 +1,14 @@
+#ifndef DISPLAY_SH1106G_H
+#define DISPLAY_SH1106G_H
+
+#include "DisplayInterface.h"
 #include <Adafruit_SH110X.h>
 #include <cstdio>  // For vsnprintf
 #include <cstdarg> // For va_list, va_start, va_end
 
-// Concrete implementation of DisplayInterface using the Adafruit_SH1106G OLED display
-class DisplaySH1106G : public DisplayInterface {
+// Concrete implementation of DisplayInterface using the Adafruit_SH1106G OLED display.
+// Declared final: calls made through a DisplaySH1106G reference need no virtual dispatch.
+class DisplaySH1106G final : public DisplayInterface {
 private:
   Adafruit_SH1106G oled;  // Instance of the Adafruit SH1106G OLED display driver
 
@@ -112,8 +117,25 @@ public:
     oled.setTextSize(size);
   }
 
+  // Read a pixel back from the display buffer
+  int getPixel(int x, int y) override {
+    return oled.getPixel(x, y);
+  }
+
+  // Set the display contrast (0-255)
+  void setContrast(uint8_t contrast) override {
+    oled.setContrast(contrast);
+  }
+
+  // Switch the panel on or off; display RAM is kept while off
+  void setPower(bool on) override {
+    oled.oled_command(on ? SH110X_DISPLAYON : SH110X_DISPLAYOFF);
+  }
+
   // Provide access to the underlying Adafruit_SH1106G object
   Adafruit_SH1106G& getDisplay() {
     return oled;
   }
 };
+
+#endif // DISPLAY_SH1106G_H
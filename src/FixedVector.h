@@ -0,0 +1,135 @@
+#ifndef FIXED_VECTOR_H
+#define FIXED_VECTOR_H
+
+#include <stddef.h>
+#if defined(ARDUINO_ARCH_AVR)
+#include <new.h>  // Placement new (Arduino AVR core 1.8.3 or later)
+#else
+#include <new>
+#endif
+
+// std::initializer_list, so that menus can be written as braced lists in both build
+// profiles. AVR toolchains ship the compiler support but not the header.
+#ifdef __has_include
+#if __has_include(<initializer_list>)
+#include <initializer_list>
+#define MENU_HAS_INITIALIZER_LIST 1
+#endif
+#endif
+
+#ifndef MENU_HAS_INITIALIZER_LIST
+namespace std {
+// Layout required by the compiler: a pointer to the elements and their count
+template <class T>
+class initializer_list {
+private:
+  const T* array;
+  size_t length;
+
+  constexpr initializer_list(const T* array, size_t length) : array(array), length(length) {}
+
+public:
+  constexpr initializer_list() : array(nullptr), length(0) {}
+  constexpr size_t size() const { return length; }
+  constexpr const T* begin() const { return array; }
+  constexpr const T* end() const { return array + length; }
+};
+}
+#endif
+
+// Vector with a capacity of N elements fixed at compile time, stored inline (no heap).
+// Implements the part of std::vector the menu uses. Elements past the capacity are
+// dropped: push_back(), insert() and emplace() do nothing when full(). Elements are
+// reset in place, never through a temporary, so large elements cost no stack.
+template <class T, size_t N>
+class FixedVector {
+private:
+  T items[N];        // Elements 0..count-1 are in use
+  size_t count = 0;
+
+  // Turns 'item' back into T() (releases what it points to)
+  static void reset(T& item) {
+    item.~T();
+    new (&item) T();
+  }
+
+public:
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  FixedVector() = default;
+
+  FixedVector(std::initializer_list<T> list) {
+    for (const T* item = list.begin(); item != list.end(); ++item) push_back(*item);
+  }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == N; }
+  size_t max_size() const { return N; }
+  size_t capacity() const { return N; }
+  void reserve(size_t) {}  // Always allocated
+
+  T& operator[](size_t index) { return items[index]; }
+  const T& operator[](size_t index) const { return items[index]; }
+  T& back() { return items[count - 1]; }
+  const T& back() const { return items[count - 1]; }
+  T* data() { return items; }
+  const T* data() const { return items; }
+
+  iterator begin() { return items; }
+  iterator end() { return items + count; }
+  const_iterator begin() const { return items; }
+  const_iterator end() const { return items + count; }
+
+  void push_back(const T& item) {
+    if (count < N) items[count++] = item;
+  }
+
+  // Removes the last element (reset to T(), so pointers to items are released)
+  void pop_back() {
+    if (count > 0) reset(items[--count]);
+  }
+
+  iterator insert(iterator position, const T& item) {
+    if (count == N) return position;
+    for (iterator i = end(); i != position; --i) *i = *(i - 1);
+    *position = item;
+    ++count;
+    return position;
+  }
+
+  // Inserts a T() at 'position', built in place, and returns it
+  iterator emplace(iterator position) {
+    if (count == N) return position;
+    for (iterator i = end(); i != position; --i) *i = *(i - 1);
+    reset(*position);
+    ++count;
+    return position;
+  }
+
+  iterator erase(iterator position) {
+    for (iterator i = position; i + 1 != end(); ++i) *i = *(i + 1);
+    pop_back();
+    return position;
+  }
+
+  void clear() {
+    while (count > 0) pop_back();
+  }
+
+  // Changes the size, up to the capacity; new elements are T()
+  void resize(size_t size) {
+    if (size > N) size = N;
+    while (count > size) pop_back();
+    while (count < size) reset(items[count++]);
+  }
+
+  void swap(FixedVector& other) {
+    FixedVector temp = other;
+    other = *this;
+    *this = temp;
+  }
+};
+
+#endif // FIXED_VECTOR_H
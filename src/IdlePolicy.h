@@ -0,0 +1,34 @@
+#ifndef IDLE_POLICY_H
+#define IDLE_POLICY_H
+
+#include <stdint.h>
+
+// Power states of the display, from fully awake to off.
+// States are ordered: each one includes the savings of the previous ones.
+enum class IdleState : uint8_t {
+  ACTIVE,     // Normal frame rate and contrast
+  THROTTLED,  // Frames limited to one per 'idleFrameInterval'
+  DIMMED,     // Throttled and contrast lowered to 'dimContrast'
+  SLEEPING    // Display switched off, nothing is rendered
+};
+
+// Timeouts (ms without user input) after which MenuDisplay saves power.
+// A timeout of 0 disables that stage; by default all stages are disabled.
+struct IdlePolicy {
+  unsigned long throttleAfter = 0;       // Lower the frame rate after this long
+  unsigned long dimAfter = 0;            // Dim the display after this long
+  unsigned long sleepAfter = 0;          // Switch the display off after this long
+  unsigned long idleFrameInterval = 1000; // Minimum time between frames while idle (ms)
+  uint8_t activeContrast = 0x7F;         // Contrast restored on wake-up
+  uint8_t dimContrast = 0x01;            // Contrast used while dimmed
+
+  // Returns the state the display should be in after 'idleTime' ms without input
+  IdleState stateFor(unsigned long idleTime) const {
+    if (sleepAfter && idleTime >= sleepAfter) return IdleState::SLEEPING;
+    if (dimAfter && idleTime >= dimAfter) return IdleState::DIMMED;
+    if (throttleAfter && idleTime >= throttleAfter) return IdleState::THROTTLED;
+    return IdleState::ACTIVE;
+  }
+};
+
+#endif // IDLE_POLICY_H
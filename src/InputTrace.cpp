@@ -0,0 +1,134 @@
+#include "InputTrace.h"
+#include <string.h>
+
+// Events followed by an argument
+static bool hasValue(TraceEvent event) {
+  return event == TraceEvent::JUMP || event == TraceEvent::MOVE || event == TraceEvent::STATUS ||
+         event == TraceEvent::NAVIGATE;
+}
+
+// Events followed by an element byte
+static bool hasElement(TraceEvent event) {
+  return event == TraceEvent::STATUS || event == TraceEvent::NAVIGATE;
+}
+
+// Zigzag encoding: small negative arguments (moveBy(-1)) stay one byte
+static uint32_t zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// ========== InputTraceRecorder ==========
+
+void InputTraceRecorder::start(unsigned long now) {
+  length = 0;
+  overflowed = false;
+  lastTime = now;
+  buffer[length++] = 'M';
+  buffer[length++] = 'D';
+  buffer[length++] = 'T';
+  buffer[length++] = VERSION;
+  writeVarint(now);  // Start time, so idle timeouts replay the same way
+}
+
+void InputTraceRecorder::record(unsigned long now, TraceEvent event, int32_t value, uint8_t element,
+                                const char* path) {
+  if (capacity - length < MAX_RECORD && flush) {
+    flush(buffer, length);
+    length = 0;
+  }
+  if (capacity - length < MAX_RECORD) {
+    overflowed = true;  // No flush callback, or a buffer below the minimum capacity
+    return;
+  }
+
+  writeVarint(now - lastTime);
+  lastTime = now;
+  buffer[length++] = (uint8_t)event;
+  if (hasElement(event)) buffer[length++] = element;
+  if (hasValue(event)) writeVarint(zigzag(value));
+  if (event == TraceEvent::NAVIGATE) {
+    const size_t pathLength = path ? strlen(path) : 0;
+    if (pathLength > TraceRecord::MAX_PATH) {
+      buffer[length++] = 0;  // Too long: replayed by id
+    } else {
+      buffer[length++] = (uint8_t)pathLength;
+      if (pathLength > 0) memcpy(buffer + length, path, pathLength);
+      length += pathLength;
+    }
+  }
+}
+
+void InputTraceRecorder::finish() {
+  if (flush && length > 0) {
+    flush(buffer, length);
+    length = 0;
+  }
+}
+
+void InputTraceRecorder::writeVarint(uint32_t value) {
+  while (value >= 0x80) {
+    buffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[length++] = (uint8_t)value;
+}
+
+// ========== InputTraceReader ==========
+
+InputTraceReader::InputTraceReader(const uint8_t* data, size_t length)
+  : data(data), length(length) {
+  uint32_t start = 0;
+  if (length < 5 || data[0] != 'M' || data[1] != 'D' || data[2] != 'T' ||
+      data[3] != InputTraceRecorder::VERSION) return;
+  position = 4;
+  valid = readVarint(start);
+  time = start;
+}
+
+bool InputTraceReader::next(TraceRecord& record) {
+  if (!valid || position >= length) return false;
+
+  uint32_t delta = 0;
+  if (!readVarint(delta) || position >= length) return valid = false;
+  const uint8_t event = data[position++];
+  if (event > (uint8_t)TraceEvent::NAVIGATE) return valid = false;
+
+  time += delta;
+  record.time = time;
+  record.event = (TraceEvent)event;
+  record.element = 0;
+  record.value = 0;
+  if (hasElement(record.event)) {
+    if (position >= length) return valid = false;
+    record.element = data[position++];
+  }
+  if (hasValue(record.event)) {
+    uint32_t value = 0;
+    if (!readVarint(value)) return valid = false;
+    record.value = unzigzag(value);
+  }
+  record.path[0] = '\0';
+  if (record.event == TraceEvent::NAVIGATE) {
+    if (position >= length) return valid = false;
+    const size_t pathLength = data[position++];
+    if (pathLength > TraceRecord::MAX_PATH || length - position < pathLength) return valid = false;
+    memcpy(record.path, data + position, pathLength);
+    record.path[pathLength] = '\0';
+    position += pathLength;
+  }
+  return true;
+}
+
+bool InputTraceReader::readVarint(uint32_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 35 && position < length; shift += 7) {
+    const uint8_t byte = data[position++];
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+  return false;  // Truncated
+}
@@ -0,0 +1,102 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Calls recorded in an input trace. The first six match MenuInput.
+enum class TraceEvent : uint8_t {
+  UP,          // scrollUp()
+  DOWN,        // scrollDown()
+  LEFT,        // scrollLeft()
+  RIGHT,       // scrollRight()
+  SELECT,      // select()
+  BACK,        // goBack()
+  PAGE_UP,     // pageUp()
+  PAGE_DOWN,   // pageDown()
+  HOME,        // home()
+  END,         // end()
+  JUMP,        // jumpTo(value)
+  MOVE,        // moveBy(value)
+  INVALIDATE,  // invalidate()
+  STATUS,      // traceStatus(element, value): a status bar element changed
+  UPDATE,      // update() that sent a frame or changed the idle state
+  RENDER,      // render() called directly
+  NAVIGATE     // navigateTo(path or value, element != 0): value is the MenuPathId
+};
+
+// One call read back from a trace
+struct TraceRecord {
+  static const size_t MAX_PATH = 39;    // Longest path recorded with NAVIGATE (longer ones: id only)
+
+  unsigned long time = 0;               // millis() at the call
+  TraceEvent event = TraceEvent::UPDATE;
+  uint8_t element = 0;                  // STATUS: application-defined element number; NAVIGATE: open flag
+  int32_t value = 0;                    // JUMP, MOVE, STATUS, NAVIGATE: argument
+  char path[MAX_PATH + 1] = {};         // NAVIGATE: the path passed to navigateTo(), "" = called with an id
+};
+
+// Called when the trace buffer is full, e.g. to append it to a file or send it over
+// Serial; the buffer is reused afterwards
+using TraceFlush = void(*)(const uint8_t* data, size_t length);
+
+// Writes calls into a compact binary trace: a header ('M', 'D', 'T', version, start
+// time) followed by one record per call: the time since the previous record (ms) and
+// the event, both as variable-length integers, plus the argument if the event has one.
+// NAVIGATE also stores the path (a length byte and the characters), so that paths into
+// lazy submenus replay the same way. Most records take 2 bytes. Recording never allocates: the trace goes into a buffer
+// supplied by the caller, drained by a TraceFlush callback when it fills up.
+class InputTraceRecorder {
+public:
+  static const uint8_t VERSION = 2;      // Format version, bumped when the layout changes
+  static const size_t MAX_RECORD = 13 + TraceRecord::MAX_PATH;  // Largest encoded record (bytes)
+
+  // 'capacity' must be at least 64 bytes
+  InputTraceRecorder(uint8_t* buffer, size_t capacity, TraceFlush flush = nullptr)
+    : buffer(buffer), capacity(capacity), flush(flush) {}
+
+  void start(unsigned long now);  // Discard the buffer and write the header
+  void record(unsigned long now, TraceEvent event, int32_t value = 0, uint8_t element = 0,
+              const char* path = nullptr);
+  void finish();                  // Flush what is left in the buffer
+
+  // Recorded bytes not flushed yet
+  const uint8_t* getData() const { return buffer; }
+  size_t getLength() const { return length; }
+
+  // Whether records were dropped because the buffer was full and there is no flush callback
+  bool hasOverflowed() const { return overflowed; }
+
+private:
+  uint8_t* buffer;
+  size_t capacity;
+  TraceFlush flush;
+  size_t length = 0;
+  unsigned long lastTime = 0;  // Time of the previous record
+  bool overflowed = false;
+
+  void writeVarint(uint32_t value);  // 7 bits per byte, high bit = more bytes follow
+};
+
+// Reads the records of a trace written by InputTraceRecorder
+class InputTraceReader {
+public:
+  InputTraceReader(const uint8_t* data, size_t length);
+
+  // Whether the header is valid
+  bool isValid() const { return valid; }
+
+  // Reads the next record; returns false at the end of the trace or on corrupt data
+  bool next(TraceRecord& record);
+
+private:
+  const uint8_t* data;
+  size_t length;
+  size_t position = 0;
+  unsigned long time = 0;  // Time of the previous record
+  bool valid = false;
+
+  bool readVarint(uint32_t& value);
+};
+
+#endif // INPUT_TRACE_H
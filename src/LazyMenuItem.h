@@ -0,0 +1,63 @@
+#ifndef LAZY_MENU_ITEM_H
+#define LAZY_MENU_ITEM_H
+
+#include "MenuItem.h"
+
+// Function pointer building the items of a lazy submenu
+using MenuFactory = MenuItemList(*)();
+
+// When MenuDisplay releases the children of lazy submenus
+enum class LazyEvictionPolicy {
+    NEVER,    // Keep every submenu once it has been built
+    ON_BACK,  // Release a submenu as soon as goBack() leaves it
+    LRU       // Keep only the most recently entered submenus (see setLazyEvictionPolicy)
+};
+
+// Menu item whose submenu is built by a factory the first time it is entered,
+// and which can be released again to save RAM (dynamic profile only). Changes
+// made to the children (e.g. with insertItem()) are lost when it is released.
+class LazyMenuItem : public MenuItem {
+private:
+    MenuFactory factory;  // Builds the submenu items
+    bool built = false;   // Whether the submenu currently exists
+
+public:
+    LazyMenuItem(MenuLabel label, MenuFactory factory)
+        : MenuItem(label), factory(factory) {}
+
+    // Lazy submenu with a translated label (the text of 'id' in the active language)
+    LazyMenuItem(StringId id, MenuFactory factory)
+        : MenuItem(id), factory(factory) {}
+
+    // A lazy item always leads to a submenu, even before it is built
+    bool hasSubmenu() const override {
+        return factory != nullptr || MenuItem::hasSubmenu();
+    }
+
+    bool isLazy() const override {
+        return true;
+    }
+
+    // Runs the factory unless the submenu already exists
+    void buildSubmenu() override {
+        if (built || !factory) return;
+        setSubmenu(factory());
+        built = true;
+    }
+
+    // Frees the children; they are rebuilt the next time the submenu is entered.
+    // In the static profile the arena never frees anything, so the children are kept.
+    bool releaseSubmenu() override {
+        if (!built || MENU_STATIC_PROFILE) return false;
+        clearSubmenu();
+        built = false;
+        return true;
+    }
+
+    // Whether the submenu currently exists
+    bool isBuilt() const {
+        return built;
+    }
+};
+
+#endif // LAZY_MENU_ITEM_H
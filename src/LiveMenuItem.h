@@ -0,0 +1,161 @@
+#ifndef LIVE_MENU_ITEM_H
+#define LIVE_MENU_ITEM_H
+
+#include "MenuItem.h"
+#include <stdio.h>   // For snprintf
+#include <string.h>  // For strcmp, memcpy
+
+// Size of the fixed text buffer of a live item (including the terminating '\0')
+#ifndef LIVE_ITEM_TEXT_SIZE
+#define LIVE_ITEM_TEXT_SIZE 32
+#endif
+
+// Function pointer returning the current value of a live item (e.g. a sensor reading)
+using LiveValueSource = float(*)();
+
+// Function pointer formatting 'value' into 'buffer' (at most 'size' bytes, '\0' included)
+// Example: snprintf(buffer, size, "%s: %dC", label, (int)value);
+using LiveValueFormatter = void(*)(char* buffer, size_t size, const char* label, float value);
+
+// Menu item whose text shows a value that changes over time, e.g. "Temp: 23.4".
+// The value is read either from a source function or from a bound variable,
+// at most once every 'refreshInterval' milliseconds. Formatting happens into
+// fixed-size buffers, so refreshing never allocates.
+class LiveMenuItem : public MenuItem {
+private:
+    LiveValueSource source = nullptr;         // Function providing the value
+    const volatile float* boundValue = nullptr; // Variable providing the value
+    LiveValueFormatter formatter = nullptr;   // Optional custom formatter
+    unsigned long refreshInterval;            // Minimum time between two reads (ms)
+    unsigned long lastRefresh = 0;            // Time of the last read (ms)
+    bool hasRefreshed = false;                // Whether the value was read at least once
+    char text[LIVE_ITEM_TEXT_SIZE];           // Last formatted text
+    MenuText glyphs;                          // 'text' decoded into glyph indices
+    uint16_t textGeneration = 0;              // MenuStrings generation 'text' was formatted for
+    int valueStart = -1;                      // First value glyph of "<label>: <value>" (-1 = other format)
+    int labelLength = 0;                      // Label glyphs before the ": " separator
+
+    // Default formatter: "<label>: <value>" with one decimal (no %f, which AVR lacks)
+    static void formatDefault(char* buffer, size_t size, const char* label, float value) {
+        long tenths = (long)(value * 10.0f + (value < 0 ? -0.5f : 0.5f));
+        const char* sign = (tenths < 0) ? "-" : "";
+        if (tenths < 0) tenths = -tenths;
+        snprintf(buffer, size, "%s: %s%ld.%ld", label, sign, tenths / 10, tenths % 10);
+    }
+
+    // Shows the label until the first value is read
+    void initText() {
+        snprintf(text, sizeof(text), "%s", getLabelText());
+        glyphs.reserve(LIVE_ITEM_TEXT_SIZE);  // Refreshing never grows it
+        glyphs.assign(text);
+        valueStart = -1;
+    }
+
+    // Finds the value in "<label>: <value>" texts, for label/value layouts
+    void splitValue() {
+        const char* label = getLabelText();
+        const size_t length = strlen(label);
+        valueStart = -1;
+        if (strncmp(text, label, length) != 0 || text[length] != ':' || text[length + 1] != ' ') return;
+
+        labelLength = 0;
+        for (size_t i = 0; i < length; ++i) {
+            if ((label[i] & 0xC0) != 0x80) ++labelLength;  // Count UTF-8 lead bytes only
+        }
+        valueStart = labelLength + 2;
+    }
+
+    // Reads the current value from whichever source is bound
+    float readValue() const {
+        if (source) return source();
+        if (boundValue) return *boundValue;
+        return 0.0f;
+    }
+
+public:
+    // Live item reading its value from a source function
+    LiveMenuItem(MenuLabel label, LiveValueSource source,
+                 LiveValueFormatter formatter = nullptr,
+                 unsigned long refreshInterval = 1000,
+                 MenuAction action = nullptr)
+        : MenuItem(label, action), source(source), formatter(formatter),
+          refreshInterval(refreshInterval) {
+        initText();
+    }
+
+    // Live item bound to a variable that is updated elsewhere (e.g. by an ISR or task)
+    LiveMenuItem(MenuLabel label, const volatile float* value,
+                 LiveValueFormatter formatter = nullptr,
+                 unsigned long refreshInterval = 1000,
+                 MenuAction action = nullptr)
+        : MenuItem(label, action), boundValue(value), formatter(formatter),
+          refreshInterval(refreshInterval) {
+        initText();
+    }
+
+    // Live items with a translated label (the text of 'id' in the active language)
+    LiveMenuItem(StringId id, LiveValueSource source,
+                 LiveValueFormatter formatter = nullptr,
+                 unsigned long refreshInterval = 1000,
+                 MenuAction action = nullptr)
+        : MenuItem(id, action), source(source), formatter(formatter),
+          refreshInterval(refreshInterval) {
+        initText();
+    }
+
+    LiveMenuItem(StringId id, const volatile float* value,
+                 LiveValueFormatter formatter = nullptr,
+                 unsigned long refreshInterval = 1000,
+                 MenuAction action = nullptr)
+        : MenuItem(id, action), boundValue(value), formatter(formatter),
+          refreshInterval(refreshInterval) {
+        initText();
+    }
+
+    // Returns the last formatted text
+    const char* getText() const override {
+        return text;
+    }
+
+    // Returns the last formatted text decoded into glyph indices
+    const MenuText& getGlyphs() const override {
+        return glyphs;
+    }
+
+    // Reads and formats the value if the refresh interval has elapsed or the language changed.
+    // Returns true only when the formatted text differs from the previous one.
+    bool refresh(unsigned long now) override {
+        const bool languageChanged = (textGeneration != MenuStrings::getGeneration());
+        if (hasRefreshed && !languageChanged && now - lastRefresh < refreshInterval) return false;
+        lastRefresh = now;
+        hasRefreshed = true;
+        textGeneration = MenuStrings::getGeneration();
+
+        char next[LIVE_ITEM_TEXT_SIZE];
+        (formatter ? formatter : formatDefault)(next, sizeof(next), getLabelText(), readValue());
+        if (strcmp(next, text) == 0) return false;
+
+        memcpy(text, next, sizeof(text));
+        glyphs.assign(text);  // Decoded once per change, not per frame
+        splitValue();
+        return true;
+    }
+
+    // Returns the start of the value after "<label>: ", or -1 for other formats
+    int getValueStart(int& labelGlyphs) const override {
+        labelGlyphs = labelLength;
+        return valueStart;
+    }
+
+    // Sets the minimum time between two reads of the value (ms)
+    void setRefreshInterval(unsigned long interval) {
+        refreshInterval = interval;
+    }
+
+    // Returns the minimum time between two reads of the value (ms)
+    unsigned long getRefreshInterval() const {
+        return refreshInterval;
+    }
+};
+
+#endif // LIVE_MENU_ITEM_H
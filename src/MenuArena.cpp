@@ -0,0 +1,39 @@
+#include "MenuConfig.h"
+
+#if MENU_STATIC_PROFILE
+
+static uint8_t arena[MENU_ARENA_SIZE];  // Counted by the linker as static RAM
+static size_t arenaUsed = 0;
+static bool arenaOverflowed = false;
+static MenuArena::OverflowHandler overflowHandler = nullptr;
+
+void* MenuArena::allocate(size_t size, size_t alignment) {
+  const uintptr_t start = (uintptr_t)arena;
+  const uintptr_t aligned = (start + arenaUsed + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  const size_t offset = aligned - start;
+  if (offset + size > MENU_ARENA_SIZE) {
+    arenaOverflowed = true;
+    if (overflowHandler) overflowHandler(size);
+    return nullptr;
+  }
+  arenaUsed = offset + size;
+  return arena + offset;
+}
+
+size_t MenuArena::used() {
+  return arenaUsed;
+}
+
+size_t MenuArena::capacity() {
+  return MENU_ARENA_SIZE;
+}
+
+void MenuArena::setOverflowHandler(OverflowHandler handler) {
+  overflowHandler = handler;
+}
+
+bool MenuArena::overflowed() {
+  return arenaOverflowed;
+}
+
+#endif
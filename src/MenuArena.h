@@ -0,0 +1,62 @@
+#ifndef MENU_ARENA_H
+#define MENU_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Static storage for the menu objects of the static build profile (see MenuConfig.h).
+// Objects are placed one after the other in a buffer of MENU_ARENA_SIZE bytes that
+// lives in .bss, so the linker's RAM report includes it. Nothing is ever freed:
+// build the menu once, at startup.
+class MenuArena {
+public:
+  // Called with the requested size when an allocation does not fit, e.g. to print an
+  // error or halt; the object is not created and makeMenuObject() returns an empty pointer
+  using OverflowHandler = void(*)(size_t size);
+
+  // Returns 'size' bytes aligned to 'alignment', or nullptr when the arena is full
+  static void* allocate(size_t size, size_t alignment);
+
+  static size_t used();      // Bytes handed out so far
+  static size_t capacity();  // MENU_ARENA_SIZE
+
+  // Sets the function called when the arena runs out (nullptr = none)
+  static void setOverflowHandler(OverflowHandler handler);
+
+  // Whether an allocation has failed since startup (raise MENU_ARENA_SIZE)
+  static bool overflowed();
+};
+
+// Pointer to an object in the MenuArena, standing in for std::shared_ptr (and
+// std::weak_ptr) in the static profile. It never owns or deletes the object.
+template <class T>
+class StaticPtr {
+private:
+  T* pointer = nullptr;
+
+public:
+  StaticPtr() = default;
+  StaticPtr(decltype(nullptr)) {}
+  explicit StaticPtr(T* pointer) : pointer(pointer) {}
+
+  // Converts from pointers to derived classes, like std::shared_ptr
+  template <class U>
+  StaticPtr(const StaticPtr<U>& other) : pointer(other.get()) {}
+
+  T* get() const { return pointer; }
+  T& operator*() const { return *pointer; }
+  T* operator->() const { return pointer; }
+  explicit operator bool() const { return pointer != nullptr; }
+
+  // Weak references are the same pointers (objects are never freed)
+  StaticPtr lock() const { return *this; }
+
+  template <class U>
+  bool operator==(const StaticPtr<U>& other) const { return pointer == other.get(); }
+  template <class U>
+  bool operator!=(const StaticPtr<U>& other) const { return pointer != other.get(); }
+  bool operator==(decltype(nullptr)) const { return pointer == nullptr; }
+  bool operator!=(decltype(nullptr)) const { return pointer != nullptr; }
+};
+
+#endif // MENU_ARENA_H
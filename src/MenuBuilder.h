@@ -2,23 +2,83 @@
 #define MENU_BUILDER_H
 
 #include "MenuItem.h"
-#include <memory>
-#include <vector>
+#include "LiveMenuItem.h"
+#include "LazyMenuItem.h"
+#include "TaskMenuItem.h"
 
 // Utility class to simplify the creation of menu items and submenus
 class MenuBuilder {
 public:
     // Creates a simple menu item with a label and optional action callback
-    static std::shared_ptr<MenuItem> createItem(const std::string& label, MenuAction action = nullptr) {
-        return std::make_shared<MenuItem>(label, action);
+    static MenuItemPtr createItem(MenuLabel label, MenuAction action = nullptr) {
+        return makeMenuObject<MenuItem>(label, action);
+    }
+
+    // Creates a menu item whose label is the text of 'id' in the active StringTable
+    static MenuItemPtr createItem(StringId id, MenuAction action = nullptr) {
+        return makeMenuObject<MenuItem>(id, action);
     }
 
     // Creates a menu item that acts as a parent for a submenu
-    static std::shared_ptr<MenuItem> createMenu(const std::string& label, const std::vector<std::shared_ptr<MenuItem>>& submenu) {
-        auto item = std::make_shared<MenuItem>(label); // Create a menu item with a label
-        item->setSubmenu(submenu);                     // Attach the submenu to this item
+    static MenuItemPtr createMenu(MenuLabel label, const MenuItemList& submenu) {
+        auto item = makeMenuObject<MenuItem>(label); // Create a menu item with a label
+        if (item) item->setSubmenu(submenu);           // Attach the submenu to this item
+        return item;
+    }
+
+    // Creates a submenu parent with a translated label
+    static MenuItemPtr createMenu(StringId id, const MenuItemList& submenu) {
+        auto item = makeMenuObject<MenuItem>(id);
+        if (item) item->setSubmenu(submenu);
         return item;
     }
+
+    // Creates a menu item whose submenu is built by 'factory' when it is first entered
+    static MenuPtr<LazyMenuItem> createLazyMenu(MenuLabel label, MenuFactory factory) {
+        return makeMenuObject<LazyMenuItem>(label, factory);
+    }
+
+    // Creates a lazy submenu parent with a translated label
+    static MenuPtr<LazyMenuItem> createLazyMenu(StringId id, MenuFactory factory) {
+        return makeMenuObject<LazyMenuItem>(id, factory);
+    }
+
+    // Creates a menu item showing a value read from 'source' every 'refreshInterval' ms
+    static MenuPtr<LiveMenuItem> createLiveItem(MenuLabel label, LiveValueSource source,
+                                                        LiveValueFormatter formatter = nullptr,
+                                                        unsigned long refreshInterval = 1000) {
+        return makeMenuObject<LiveMenuItem>(label, source, formatter, refreshInterval);
+    }
+
+    // Creates a menu item showing the value of a variable, re-read every 'refreshInterval' ms
+    static MenuPtr<LiveMenuItem> createLiveItem(MenuLabel label, const volatile float* value,
+                                                        LiveValueFormatter formatter = nullptr,
+                                                        unsigned long refreshInterval = 1000) {
+        return makeMenuObject<LiveMenuItem>(label, value, formatter, refreshInterval);
+    }
+
+    // Live items with a translated label
+    static MenuPtr<LiveMenuItem> createLiveItem(StringId id, LiveValueSource source,
+                                                        LiveValueFormatter formatter = nullptr,
+                                                        unsigned long refreshInterval = 1000) {
+        return makeMenuObject<LiveMenuItem>(id, source, formatter, refreshInterval);
+    }
+
+    static MenuPtr<LiveMenuItem> createLiveItem(StringId id, const volatile float* value,
+                                                        LiveValueFormatter formatter = nullptr,
+                                                        unsigned long refreshInterval = 1000) {
+        return makeMenuObject<LiveMenuItem>(id, value, formatter, refreshInterval);
+    }
+
+    // Creates a menu item running 'step' in the background when selected (see TaskMenuItem)
+    static MenuPtr<TaskMenuItem> createTaskItem(MenuLabel label, MenuTaskStep step) {
+        return makeMenuObject<TaskMenuItem>(label, step);
+    }
+
+    // Task item with a translated label
+    static MenuPtr<TaskMenuItem> createTaskItem(StringId id, MenuTaskStep step) {
+        return makeMenuObject<TaskMenuItem>(id, step);
+    }
 };
 
 #endif // MENU_BUILDER_H
@@ -0,0 +1,146 @@
+#ifndef MENU_CONFIG_H
+#define MENU_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Build profile.
+// The dynamic profile (default) keeps labels in std::string, children in std::vector and
+// items in std::shared_ptr. The static profile is for AVR-class targets without the C++
+// standard library: fixed-capacity containers, 'const char*' labels and items placed once
+// in a static arena. It is selected on AVR; define MENU_STATIC_PROFILE as 0 or 1 to choose.
+// Application code written with MenuBuilder, makeMenuObject() and the types below
+// (MenuPtr, MenuItemList) compiles unchanged in both.
+#ifndef MENU_STATIC_PROFILE
+#if defined(ARDUINO_ARCH_AVR)
+#define MENU_STATIC_PROFILE 1
+#else
+#define MENU_STATIC_PROFILE 0
+#endif
+#endif
+
+// ---- Capacities of the static profile (ignored by the dynamic profile) ----
+
+// Bytes of the arena holding every menu item, layout, overlay and status element
+#ifndef MENU_ARENA_SIZE
+#define MENU_ARENA_SIZE 768
+#endif
+
+// Children of one menu item
+#ifndef MENU_MAX_CHILDREN
+#define MENU_MAX_CHILDREN 8
+#endif
+
+// Glyphs decoded per label (longer labels are cut)
+#ifndef MENU_MAX_LABEL_LENGTH
+#define MENU_MAX_LABEL_LENGTH 20
+#endif
+
+// Cells of a layout (visible items)
+#ifndef MENU_MAX_CELLS
+#define MENU_MAX_CELLS 8
+#endif
+
+// Status bar elements on each side
+#ifndef MENU_MAX_STATUS_ELEMENTS
+#define MENU_MAX_STATUS_ELEMENTS 3
+#endif
+
+// Maximum text length of the built-in toast and dialog overlays (both profiles)
+#ifndef OVERLAY_TEXT_SIZE
+#define OVERLAY_TEXT_SIZE 24
+#endif
+
+// Bytes of text read from a PROGMEM StringTable, longer texts are cut (both profiles)
+#ifndef MENU_MAX_STRING_BYTES
+#define MENU_MAX_STRING_BYTES (2 * MENU_MAX_LABEL_LENGTH)
+#endif
+
+// Overlays on screen at once
+#ifndef MENU_MAX_OVERLAYS
+#define MENU_MAX_OVERLAYS 1
+#endif
+
+// Pixels saved under each overlay (1 bit per pixel), part of every MenuDisplay. The
+// default fits a toast (14 pixels high) of OVERLAY_TEXT_SIZE - 1 characters on a 128
+// pixel wide display; larger overlays are refused. ConfirmDialog (28 pixels high) is an
+// opt-in: define MENU_OVERLAY_SAVE_BYTES as MENU_OVERLAY_SAVE_BYTES_FOR(28).
+#define MENU_OVERLAY_SAVE_BYTES_FOR(height) \
+  ((((OVERLAY_TEXT_SIZE - 1) * 6 + 8 < 128 ? (OVERLAY_TEXT_SIZE - 1) * 6 + 8 : 128) * (height) + 7) / 8)
+#ifndef MENU_OVERLAY_SAVE_BYTES
+#define MENU_OVERLAY_SAVE_BYTES MENU_OVERLAY_SAVE_BYTES_FOR(14)
+#endif
+
+// Background tasks running at once, and lazy submenus tracked for eviction
+#ifndef MENU_MAX_TASKS
+#define MENU_MAX_TASKS 2
+#endif
+#ifndef MENU_MAX_LAZY_MENUS
+#define MENU_MAX_LAZY_MENUS 4
+#endif
+
+// Slots of the path index used by navigateTo() (a power of two, 8 bytes each). Three
+// quarters of them are used; items past that can only be reached by path, not by id.
+#ifndef MENU_INDEX_SLOTS
+#define MENU_INDEX_SLOTS 16
+#endif
+
+#if MENU_STATIC_PROFILE
+#include "FixedVector.h"
+#include "MenuArena.h"  // FixedVector.h brings placement new
+
+// Vector of at most N elements
+template <class T, size_t N>
+using MenuVector = FixedVector<T, N>;
+
+// Shared and weak references to menu objects
+template <class T>
+using MenuPtr = StaticPtr<T>;
+template <class T>
+using MenuWeakPtr = StaticPtr<T>;
+
+// Label storage and the label parameter of constructors
+using MenuString = const char*;
+using MenuLabel = const char*;
+
+inline const char* menuCString(const char* text) {
+  return text ? text : "";
+}
+
+// Creates a menu object in the arena (std::make_shared in the dynamic profile).
+// Returns an empty pointer when MENU_ARENA_SIZE is exhausted, after calling the
+// MenuArena overflow handler; menus ignore empty items.
+template <class T, class... Args>
+MenuPtr<T> makeMenuObject(Args... args) {
+  void* memory = MenuArena::allocate(sizeof(T), alignof(T));
+  return memory ? MenuPtr<T>(new (memory) T(args...)) : MenuPtr<T>();
+}
+
+#else
+#include <vector>
+#include <memory>
+#include <string>
+#include <utility>
+
+template <class T, size_t N>
+using MenuVector = std::vector<T>;
+
+template <class T>
+using MenuPtr = std::shared_ptr<T>;
+template <class T>
+using MenuWeakPtr = std::weak_ptr<T>;
+
+using MenuString = std::string;
+using MenuLabel = const std::string&;
+
+inline const char* menuCString(const std::string& text) {
+  return text.c_str();
+}
+
+template <class T, class... Args>
+MenuPtr<T> makeMenuObject(Args&&... args) {
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+#endif
+
+#endif // MENU_CONFIG_H
@@ -2,7 +2,12 @@
 
 // Main render function - draws all visual components to the screen
 void MenuDisplay::render() {
-  if (renderDisplay) {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::RENDER);
+  applyLayout();
+  refreshStrings();  // This frame shows the active language; update() need not repaint it
+  refreshLiveItems();
+  if (renderDisplay && idleState != IdleState::SLEEPING) {
     display.clearDisplay();
     if (showStatusBar) {
       // Draw top bar background or line if transparent
@@ -16,7 +21,24 @@ void MenuDisplay::render() {
     renderRightElements();        // Draw right-aligned status symbols
     renderMenu();                 // Draw menu items
     renderScrollIndicator();      // Draw scroll position indicator
+
+    // Overlays go on top of the fresh frame: drop dismissed ones, save and draw the rest
+    for (size_t i = 0; i < overlays.size();) {
+      if (overlays[i].removed) {
+        overlays.erase(overlays.begin() + i);
+      } else {
+        overlays[i++].shown = false;
+      }
+    }
+    damage.clear();
+    compositeOverlays();
+
     display.display();            // Commit changes to screen
+    fullRedraw = false;
+    dirtyRows = 0;
+    scrollbarDirty = false;
+    lastFrameTime = millis();
+    ++frameCount;
   }
 }
 
@@ -78,83 +100,128 @@ void MenuDisplay::renderRightElements() const {
 
 // Draws the visible portion of the menu
 void MenuDisplay::renderMenu() const {
-  constexpr int lineHeight = 10;
-  constexpr int prefixWidth = 12;
-  constexpr int charWidth = 6;
-
-  const int startY = showStatusBar ? statusBarHeight + 2 : 0;
-  const int scrollbarWidth = (currentMenu.size() > visibleElements) ? 3 : 0;
-  const int contentWidth = display.width() - 4 - scrollbarWidth;
-
   display.setTextWrap(false);
   display.setTextColor(1);
 
-  auto getVisibleText = [&](const std::string& label, bool isSelected, int availableWidth) -> std::string {
-    if (!isSelected || label.length() * charWidth <= availableWidth)
-      return label;
+  for (int i = 0; i < visibleElements; ++i) {
+    if (scrollOffset + i >= (int)currentMenu().size()) break;
+    renderCell(i);
+  }
+}
 
-    if (!isScrollingManually) {
-      int maxChars = availableWidth / charWidth;
-      return (maxChars > 3) ? label.substr(0, maxChars - 3) + "..." : "...";
-    }
+// Draws one visible menu cell (0 = first visible cell), clearing its background first
+void MenuDisplay::renderCell(int cell) const {
+  const MenuRect& rect = layout->getCell(cell);
+  const int idx = scrollOffset + cell;
 
-    // Scroll manual: permitem un pas în plus ca ultimul caracter să fie complet vizibil
-    int labelPixelWidth = label.length() * charWidth;
-    int maxScroll = std::max(0, labelPixelWidth - availableWidth);
-    int pixelOffset = std::min(manualScrollOffset, maxScroll);
+  // Clear background (cells past the end of a shrunk menu stay empty)
+  display.fillRect(rect.x, rect.y, rect.w, rect.h, 0);
+  if (idx >= (int)currentMenu().size()) return;
 
-    int currentX = 0, startChar = 0;
-    while (startChar <= label.size() && currentX + charWidth <= pixelOffset) {
-      currentX += charWidth;
-      ++startChar;
-    }
+  MenuCellState state;
+  state.selected = (idx == selectedIndex);
+  state.textOffset = (state.selected && isScrollingManually) ? manualScrollOffset : -1;
+  if ((int)currentMenu().size() > visibleElements && rect.x + rect.w > displayHSize - 4) {
+    state.reservedRight = 3;  // Scrollbar
+  }
+  layout->drawCell(display, *currentMenu()[idx], rect, state);
+}
 
-    std::string result;
-    int drawnWidth = currentX - pixelOffset;
+// Recomputes the layout's cell table for the current display and status bar size
+void MenuDisplay::applyLayout() {
+  if (!layoutDirty) return;
+  const int top = showStatusBar ? statusBarHeight + 2 : 0;
+  layout->computeCells(MenuRect(0, top, displayHSize, displayVSize - top), visibleRows);
+  visibleElements = constrain(layout->getCellCount(), 1, MAX_VISIBLE_ROWS);
+  layoutColumns = max(1, layout->getColumns());
+  layoutDirty = false;
+  keepSelectionVisible();
+  fullRedraw = true;
+}
 
-    for (size_t j = startChar; j < label.size() && drawnWidth + charWidth <= availableWidth; ++j) {
-      result += label[j];
-      drawnWidth += charWidth;
-    }
+// Repaints only what changed since the last frame
+void MenuDisplay::update() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::UPDATE);
+  runTasks();  // Tasks also run while the display is off or idle
+  if (!renderDisplay) return;
 
-    return result;
-  };
+  const unsigned long now = millis();
+  updateIdleState(now);
+  if (idleState == IdleState::SLEEPING) return;  // Display is off, nothing to paint
 
-  for (int i = 0; i < visibleElements; ++i) {
-    int idx = scrollOffset + i;
-    if (idx >= currentMenu.size()) break;
-
-    const std::string& label = currentMenu[idx]->getLabel();
-    bool isSelected = (idx == selectedIndex);
-    int availableWidth = contentWidth - (isSelected ? prefixWidth : 0);
-    int y = startY + i * lineHeight;
-
-    // Clear background
-    display.fillRect(2, y, display.width() - 4, lineHeight, 0);
-
-    // Draw selection indicator
-    int textStartX = 2;
-    if (isSelected) {
-      display.setCursor(textStartX, y);
-      display.print("> ");
-      textStartX += prefixWidth;
-    }
+  // While idle, changes (live values, status bar) are batched into one frame per interval
+  if (idleState != IdleState::ACTIVE && now - lastFrameTime < idlePolicy.idleFrameInterval) return;
 
-    // Compute visible text
-    std::string visibleText = getVisibleText(label, isSelected, availableWidth);
+  applyLayout();
+  refreshStrings();
+  refreshLiveItems();
+  expireOverlays(now);
 
-    // Draw text
-    display.setCursor(textStartX, y);
-    display.print(visibleText.c_str());
+  if (fullRedraw) {
+    render();
+    return;
   }
-}
+  const bool menuChanged = (dirtyRows != 0 || scrollbarDirty);
+  if (!menuChanged && !overlaysChanged()) return;
 
+  // Without read-back there is no save-under: repaint everything below the overlays
+  if (!overlays.empty() && display.getPixel(0, 0) < 0) {
+    render();
+    return;
+  }
 
+  // Collect the areas about to be repainted and show the menu pixels there
+  const int scrollbarTop = showStatusBar ? statusBarHeight + 1 : 0;
+  damage.clear();
+  if (menuChanged) {
+    for (int i = 0; i < visibleElements; ++i) {
+      if (dirtyRows & (1UL << i)) {
+        damage.push_back(layout->getCell(i));
+      }
+    }
+    damage.push_back(MenuRect(displayHSize - 3, scrollbarTop, 3, displayVSize - scrollbarTop));
+  }
+  for (const auto& slot : overlays) {
+    if (slot.removed && slot.shown) damage.push_back(slot.overlay->getBounds());
+  }
+  liftOverlays();
+  for (size_t i = 0; i < overlays.size();) {
+    if (overlays[i].removed) {
+      overlays.erase(overlays.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+
+  if (menuChanged) {
+    display.setTextWrap(false);
+    display.setTextColor(1);
+    for (int i = 0; i < visibleElements; ++i) {
+      if (dirtyRows & (1UL << i)) {
+        renderCell(i);
+      }
+    }
+    dirtyRows = 0;
+
+    if (scrollbarDirty) {
+      // Marker position or item count changed: erase the old indicator first
+      display.fillRect(displayHSize - 3, scrollbarTop, 3, displayVSize - scrollbarTop, 0);
+      scrollbarDirty = false;
+    }
+    renderScrollIndicator();  // Row backgrounds overlap the scroll marker
+  }
+
+  compositeOverlays();
+  display.display();
+  lastFrameTime = now;
+  ++frameCount;
+}
 
 // Renders the scroll indicator on the right side of the display
 void MenuDisplay::renderScrollIndicator() const {
   int barX = displayHSize - 2;
-  int totalItems = currentMenu.size();
+  int totalItems = currentMenu().size();
   int scrollOffsetY = showStatusBar ? (statusBarHeight + 3) : 2;
   int barHeight = displayVSize - scrollOffsetY - 1;
 
@@ -167,7 +234,7 @@ void MenuDisplay::renderScrollIndicator() const {
   }
 
   // Draw scroll position marker
-  float percent = selectedIndex / (float)(totalItems - 1);
+  float percent = (totalItems > 1) ? selectedIndex / (float)(totalItems - 1) : 0.0f;
   int centerY = scrollOffsetY + (int)(percent * (barHeight - 1));
 
   for (int dy = -1; dy <= 1; dy++) {
@@ -177,85 +244,153 @@ void MenuDisplay::renderScrollIndicator() const {
   }
 }
 
-// Sets the current menu and clears history
-void MenuDisplay::setMenu(const std::vector<std::shared_ptr<MenuItem>>& menu) {
-  currentMenu = menu;
-  selectedIndex = scrollOffset = 0;
-  while (!menuHistory.empty()) menuHistory.pop();
+// Sends the display commands matching an idle state change
+void MenuDisplay::applyIdleState(IdleState from, IdleState to) {
+  if (to >= IdleState::DIMMED && from < IdleState::DIMMED) {
+    display.setContrast(idlePolicy.dimContrast);
+  } else if (to < IdleState::DIMMED && from >= IdleState::DIMMED) {
+    display.setContrast(idlePolicy.activeContrast);
+  }
+  if (to == IdleState::SLEEPING) {
+    display.setPower(false);
+  } else if (from == IdleState::SLEEPING) {
+    display.setPower(true);
+  }
 }
 
-// Navigates one item up in the menu
-void MenuDisplay::scrollUp() {
-  if (selectedIndex > 0) {
-    selectedIndex--;
-    if (selectedIndex < scrollOffset) scrollOffset--;
+// ========== OVERLAY COMPOSITOR ==========
+
+// Adds 'overlay' above all overlays with the same or a lower z-order
+bool MenuDisplay::showOverlay(const MenuPtr<Overlay>& overlay, unsigned long timeout) {
+  MenuLockGuard guard(lock);
+  if (!overlay) return false;
+  overlay->resetClose();
+
+  for (auto& slot : overlays) {
+    if (slot.overlay == overlay) {  // Already on screen: keep it, restart the timeout
+      slot.removed = false;
+      slot.shownAt = millis();
+      slot.timeout = timeout;
+      return true;
+    }
+  }
+
+  size_t pos = 0;
+  while (pos < overlays.size() && overlays[pos].overlay->getZOrder() <= overlay->getZOrder()) ++pos;
+
+  const MenuRect& bounds = overlay->getBounds();
+  const size_t saveBytes = (bounds.w * bounds.h + 7) / 8;
+  if (overlays.size() == overlays.max_size() || (MENU_STATIC_PROFILE && saveBytes > MENU_OVERLAY_SAVE_BYTES)) {
+    return false;  // Static profile limits
   }
-  manualScrollOffset = 0;
+  OverlaySlot& slot = *overlays.emplace(overlays.begin() + pos);  // Built in place, it holds the save-under buffer
+  slot.overlay = overlay;
+  slot.saveUnder.resize(saveBytes);
+  slot.shownAt = millis();
+  slot.timeout = timeout;
+  return true;
 }
 
-// Navigates one item down in the menu
-void MenuDisplay::scrollDown() {
-  if (selectedIndex < currentMenu.size() - 1) {
-    selectedIndex++;
-    if (selectedIndex >= scrollOffset + visibleElements) scrollOffset++;
+// Marks 'overlay' for removal on the next frame
+void MenuDisplay::dismissOverlay(const MenuPtr<Overlay>& overlay) {
+  MenuLockGuard guard(lock);
+  for (auto& slot : overlays) {
+    if (slot.overlay == overlay) slot.removed = true;
   }
-  manualScrollOffset = 0;
 }
 
-// Activates the selected menu item or enters a submenu
-void MenuDisplay::select() {
-  if (selectedIndex >= 0 && selectedIndex < currentMenu.size()) {
-    auto selected = currentMenu[selectedIndex];
-    if (selected && selected->hasSubmenu()) {
-      menuHistory.push(currentMenu);
-      currentMenu = selected->getSubmenu();
-      selectedIndex = scrollOffset = 0;
-    } else if (selected) {
-      selected->activate();  // Execute menu action
+// Gives navigation input to the top overlay
+bool MenuDisplay::handleOverlayInput(MenuInput input) {
+  for (size_t i = overlays.size(); i-- > 0;) {
+    if (overlays[i].removed) continue;
+    MenuPtr<Overlay> top = overlays[i].overlay;  // The handler may change 'overlays'
+    return top->handleInput(input);
+  }
+  return false;
+}
+
+// Removes overlays whose timeout elapsed or which closed themselves
+void MenuDisplay::expireOverlays(unsigned long now) {
+  for (auto& slot : overlays) {
+    if (slot.overlay->isCloseRequested() || (slot.timeout && now - slot.shownAt >= slot.timeout)) {
+      slot.removed = true;
     }
   }
-  manualScrollOffset = 0;
 }
 
-// Returns to the previous menu (if available)
-void MenuDisplay::goBack() {
-  if (!menuHistory.empty()) {
-    currentMenu = menuHistory.top();
-    menuHistory.pop();
-    selectedIndex = scrollOffset = 0;
+// Whether the next frame has overlay work even if the menu did not change
+bool MenuDisplay::overlaysChanged() const {
+  for (const auto& slot : overlays) {
+    if (slot.removed || !slot.shown || slot.overlay->isDirty()) return true;
   }
-  manualScrollOffset = 0;
+  return false;
 }
 
-// Checks if it's possible to return to a previous menu
-bool MenuDisplay::canGoBack() const {
-  return !menuHistory.empty();
+// Restores the saved pixels in the damaged areas, top overlay first, so that
+// the screen there shows the menu again before it is repainted
+void MenuDisplay::liftOverlays() {
+  for (size_t i = overlays.size(); i-- > 0;) {
+    OverlaySlot& slot = overlays[i];
+    if (!slot.shown) continue;
+    for (const MenuRect& area : damage) {
+      MenuRect part = area.intersect(slot.overlay->getBounds());
+      if (!part.isEmpty()) restoreUnder(slot, part);
+    }
+  }
 }
 
-// Horizontal scrolling controls
-void MenuDisplay::scrollLeft() {
-   if (manualScrollOffset > 0) {
-    manualScrollOffset = std::max(manualScrollOffset - charWidth, 0);
-    if (manualScrollOffset == 0) {
-      isScrollingManually = false;
+// Draws the overlays bottom to top. An overlay is saved and redrawn only where the
+// frame changed below it; its own area then counts as changed for the ones above.
+void MenuDisplay::compositeOverlays() {
+  for (auto& slot : overlays) {
+    const MenuRect bounds = slot.overlay->getBounds();
+    bool redraw = slot.overlay->isDirty();
+
+    if (!slot.shown) {
+      saveUnder(slot, bounds);
+      slot.shown = true;
+      redraw = true;
+    } else {
+      const size_t count = damage.size();  // Only areas changed below this overlay
+      for (size_t i = 0; i < count; ++i) {
+        MenuRect part = damage[i].intersect(bounds);
+        if (!part.isEmpty()) {
+          saveUnder(slot, part);
+          redraw = true;
+        }
+      }
     }
+
+    if (redraw) {
+      slot.overlay->draw(display);
+      damage.push_back(bounds);
+    }
+    slot.overlay->clearDirty();
   }
-  
 }
 
-void MenuDisplay::scrollRight() {
- if (selectedIndex >= 0 && selectedIndex < currentMenu.size()) {
-    const std::string label = currentMenu[selectedIndex]->getLabel();
-    const int textWidth = label.length() * charWidth;
-    const int availableWidth = displayHSize - prefixWidth - 4; // Account for padding
-    
-    if (textWidth > availableWidth) {
-      isScrollingManually = true;
-      manualScrollOffset = std::min(
-        manualScrollOffset + charWidth, 
-        textWidth - availableWidth
-      );
+// Copies the screen pixels of 'area' (inside the overlay bounds) into the save-under buffer
+void MenuDisplay::saveUnder(OverlaySlot& slot, const MenuRect& area) {
+  const MenuRect& bounds = slot.overlay->getBounds();
+  for (int y = area.y; y < area.y + area.h; ++y) {
+    int bit = (y - bounds.y) * bounds.w + (area.x - bounds.x);
+    for (int x = area.x; x < area.x + area.w; ++x, ++bit) {
+      if (display.getPixel(x, y) > 0) {
+        slot.saveUnder[bit >> 3] |= (1 << (bit & 7));
+      } else {
+        slot.saveUnder[bit >> 3] &= ~(1 << (bit & 7));
+      }
     }
   }
 }
 
+// Draws the saved pixels of 'area' (inside the overlay bounds) back to the screen
+void MenuDisplay::restoreUnder(OverlaySlot& slot, const MenuRect& area) {
+  const MenuRect& bounds = slot.overlay->getBounds();
+  for (int y = area.y; y < area.y + area.h; ++y) {
+    int bit = (y - bounds.y) * bounds.w + (area.x - bounds.x);
+    for (int x = area.x; x < area.x + area.w; ++x, ++bit) {
+      display.drawPixel(x, y, (slot.saveUnder[bit >> 3] >> (bit & 7)) & 1);
+    }
+  }
+}
@@ -4,48 +4,42 @@
 
 // Include necessary libraries
 #include <DisplayInterface.h>  // Graphics library for display
-#include <vector>              // For dynamic arrays
-#include <memory>              // For smart pointers
-#include <stack>               // For menu history stack
+#include "MenuDisplayBase.h"   // Menu state and navigation
 #include "StatusBarElement.h"  // Status bar element interface
-#include "MenuItem.h"          // Menu item class
-#include <Arduino.h>
+#include "Overlay.h"           // Popups, toasts and dialogs
+#include "MenuLayout.h"        // Cell geometry and drawing of the menu
 
-// Declaration of the MenuDisplay class
-class MenuDisplay {
+// Menu renderer: draws the state kept by MenuDisplayBase on any DisplayInterface
+class MenuDisplay : public MenuDisplayBase {
 private:
   // Reference to the display object (e.g. Adafruit GFX-based)
   DisplayInterface& display;
 
   // Status bar configuration
-  std::vector<std::shared_ptr<StatusBarElement>> leftElements;   // Left-aligned status bar elements
-  std::vector<std::shared_ptr<StatusBarElement>> rightElements;  // Right-aligned status bar elements
-  int elementSpacing = 2;  // Pixel spacing between status bar elements
-
-  // Menu system configuration
-  std::vector<std::shared_ptr<MenuItem>> currentMenu;  // Currently displayed menu items
-  std::stack<std::vector<std::shared_ptr<MenuItem>>> menuHistory;  // Menu navigation history stack
-  int selectedIndex = 0;    // Index of currently selected menu item
-  int scrollOffset = 0;     // Vertical scroll position for long menus
-  int visibleElements = 5;  // Number of visible menu items at once
-
-  // Horizontal scrolling control
-  int manualScrollOffset = 0;       // Current horizontal scroll offset
-  bool isScrollingManually = false; // Whether manual scrolling is active
-  const int charWidth = 6;          // Monospace character width (pixels)
-  const int prefixWidth = 12;       // Width for "> " prefix before selected item
-
-  // Top bar customization options
-  int statusBarBgColor = 1;    // Status bar background color (0/1 for monochrome)
-  int statusBarHeight = 13;    // Status bar height in pixels
-  bool showStatusBar = true;   // Whether to show status bar
-
-  // Display dimensions (default 128x64)
-  int displayVSize = 64;    // Vertical size (height)
-  int displayHSize = 128;   // Horizontal size (width)
-
-  // Display control flag
-  bool renderDisplay = true;  // Whether to render the display
+  MenuVector<MenuPtr<StatusBarElement>, MENU_MAX_STATUS_ELEMENTS> leftElements;   // Left-aligned status bar elements
+  MenuVector<MenuPtr<StatusBarElement>, MENU_MAX_STATUS_ELEMENTS> rightElements;  // Right-aligned status bar elements
+
+  // An overlay on screen together with the pixels it covers
+  struct OverlaySlot {
+    MenuPtr<Overlay> overlay;  // The widget
+    MenuVector<uint8_t, MENU_OVERLAY_SAVE_BYTES> saveUnder;  // Pixels under the overlay, 1 bit each, row by row
+    unsigned long shownAt = 0;       // Time the overlay was shown (ms)
+    unsigned long timeout = 0;       // Removed after this long (ms, 0 = until dismissed)
+    bool shown = false;              // Drawn and 'saveUnder' valid
+    bool removed = false;            // Dismissed, pixels restored on the next frame
+  };
+
+  // Overlay compositor
+  MenuVector<OverlaySlot, MENU_MAX_OVERLAYS> overlays;  // Sorted by z-order, bottom first
+  MenuVector<MenuRect, MENU_MAX_CELLS + 1 + 2 * MENU_MAX_OVERLAYS> damage;  // Areas repainted in the current frame
+#if MENU_STATIC_PROFILE
+  Toast toastBox = Toast("");  // Reused by showToast() (the arena never frees)
+#endif
+
+  // Layout
+  ListLayout listLayout;                   // Default layout
+  MenuPtr<MenuLayout> customLayout; // Layout set with setLayout()
+  MenuLayout* layout = &listLayout;         // Active layout
 
 public:
   // Constructor - takes a reference to the display
@@ -54,84 +48,112 @@ public:
 
   // ========== STATUS BAR ELEMENT MANAGEMENT ==========
 
-  // Set spacing between status bar elements
-  void setElementSpacing(int spacing) {
-    elementSpacing = spacing;
-  }
-
   // Add element to left side of status bar
-  void addLeftElement(std::shared_ptr<StatusBarElement> element) {
+  void addLeftElement(MenuPtr<StatusBarElement> element) {
+    MenuLockGuard guard(lock);
+    if (!element) return;  // Could not be created (static profile arena full)
     leftElements.push_back(element);
+    fullRedraw = true;
   }
   
   // Add element to right side of status bar
-  void addRightElement(std::shared_ptr<StatusBarElement> element) {
+  void addRightElement(MenuPtr<StatusBarElement> element) {
+    MenuLockGuard guard(lock);
+    if (!element) return;  // Could not be created (static profile arena full)
     rightElements.push_back(element);
+    fullRedraw = true;
   }
 
   // Clear all left/right status bar elements
-  void clearLeftElements();
-  void clearRightElements();
-
-  // ========== TOP BAR CONFIGURATION ==========
-
-  // Set status bar background color
-  void setStatusBarBackgroundColor(int color) {
-    statusBarBgColor = color;
+  void clearLeftElements() {
+    MenuLockGuard guard(lock);
+    leftElements.clear();
+    fullRedraw = true;
   }
 
-  // Get current status bar color
-  int getStatusBarBackgroundColor() {
-    return statusBarBgColor;
+  void clearRightElements() {
+    MenuLockGuard guard(lock);
+    rightElements.clear();
+    fullRedraw = true;
   }
 
-  // Set status bar height
-  void setStatusBarHeight(int height) {
-    statusBarHeight = height;
-  }
+  // ========== LAYOUT ==========
 
-  // Show/hide status bar
-  void setShowStatusBar(bool show) {
-    showStatusBar = show;
+  // Sets how items are arranged and drawn (nullptr = the default list)
+  void setLayout(const MenuPtr<MenuLayout>& newLayout) {
+    MenuLockGuard guard(lock);
+    customLayout = newLayout;
+    layout = customLayout ? customLayout.get() : &listLayout;
+    layoutDirty = true;
+    applyLayout();
   }
 
-  // ========== DISPLAY CONFIGURATION ==========
-
-  // Set display dimensions
-  void setDisplaySize(int width, int height) {
-    displayHSize = width;
-    displayVSize = height;
+  // Screen rectangle of item 'index' of the displayed menu (empty if it is not visible)
+  MenuRect getItemRect(int index) const {
+    MenuLockGuard guard(lock);
+    return layout->itemRect(index, scrollOffset);
   }
 
-  // Enable/disable display rendering
-  void setRenderDisplay(bool isRender) {
-    renderDisplay = isRender;
+  // Indexes of the first and last visible items (last < first if the menu is empty)
+  void getVisibleRange(int& first, int& last) const {
+    MenuLockGuard guard(lock);
+    layout->visibleRange(scrollOffset, currentMenu().size(), first, last);
   }
 
-  // Check if rendering is enabled
-  bool isRenderDisplay() {
-    return renderDisplay;
+  // ========== OVERLAYS ==========
+
+  // Shows 'overlay' above the menu until dismissed or, if 'timeout' > 0, for 'timeout' ms.
+  // Showing an overlay that is already on screen restarts its timeout. Returns false if
+  // the overlay is not shown: it is empty or, in the static profile, MENU_MAX_OVERLAYS are
+  // on screen or it covers more pixels than MENU_OVERLAY_SAVE_BYTES can save.
+  bool showOverlay(const MenuPtr<Overlay>& overlay, unsigned long timeout = 0);
+
+  // Hides 'overlay'; the pixels under it are restored on the next update()
+  void dismissOverlay(const MenuPtr<Overlay>& overlay);
+
+  // Shows a short message (e.g. "Saved") for 'timeout' ms
+  MenuPtr<Toast> showToast(const char* text, unsigned long timeout = 1500) {
+    MenuLockGuard guard(lock);
+#if MENU_STATIC_PROFILE
+    // The arena never frees, so every call reuses the display's own toast. While it is
+    // on screen only its text changes: the box keeps its size.
+    MenuPtr<Toast> toast(&toastBox);
+    bool onScreen = false;
+    for (const auto& slot : overlays) onScreen = onScreen || slot.overlay == toast;
+    if (onScreen) {
+      toast->setText(text);
+    } else {
+      toastBox = Toast(text, displayHSize, displayVSize);
+    }
+#else
+    auto toast = makeMenuObject<Toast>(text, displayHSize, displayVSize);
+#endif
+    showOverlay(toast, timeout);
+    return toast;
   }
 
-  // ========== MENU MANAGEMENT METHODS ==========
-
-  // Core menu functions
-  void setMenu(const std::vector<std::shared_ptr<MenuItem>>& menu);  // Set active menu
-  void scrollUp();      // Move selection up
-  void scrollDown();    // Move selection down
-  void scrollLeft();    // Scroll text left (for long items)
-  void scrollRight();   // Scroll text right (for long items)
-  void select();        // Activate selected item
-  void goBack();        // Return to previous menu
-  bool canGoBack() const;  // Check if back navigation is possible
-
-  // Set number of visible menu items
-  void setVisibleElements(int count) {
-    visibleElements = max(1, count);  // Ensure at least 1 item is visible
+  // Whether any overlay is on screen
+  bool hasOverlays() const {
+    MenuLockGuard guard(lock);
+    return !overlays.empty();
   }
 
+  // ========== RENDERING ==========
+
   // Main rendering function
-  void render();  // Render entire display
+  void render() final;  // Render entire display
+
+  // Incremental rendering: runs the background tasks, polls the visible live items and
+  // repaints only the rows whose text changed. Falls back to render() after navigation
+  // or invalidate().
+  void update();
+
+protected:
+  // Sends the contrast and power commands for an idle state change
+  void applyIdleState(IdleState from, IdleState to) final;
+
+  // Routes navigation input to the top overlay
+  bool handleOverlayInput(MenuInput input) final;
 
 private:
   // ========== PRIVATE RENDERING HELPERS ==========
@@ -139,7 +161,18 @@ private:
   void renderLeftElements() const;     // Render left status bar elements
   void renderRightElements() const;    // Render right status bar elements
   void renderMenu() const;             // Render menu items
+  void renderCell(int cell) const;     // Render a single visible menu cell
+  void applyLayout();                  // Recompute the cell table if the layout or display changed
   void renderScrollIndicator() const;  // Render vertical scrollbar
+
+  // ========== PRIVATE OVERLAY HELPERS ==========
+
+  void expireOverlays(unsigned long now);  // Mark timed out / closed overlays as removed
+  bool overlaysChanged() const;            // Whether an overlay must be drawn or removed
+  void liftOverlays();                     // Restore the pixels under overlays in 'damage'
+  void compositeOverlays();                // Re-save and redraw overlays touched by 'damage'
+  void saveUnder(OverlaySlot& slot, const MenuRect& area);     // Copy screen pixels into the slot
+  void restoreUnder(OverlaySlot& slot, const MenuRect& area);  // Copy slot pixels back to the screen
 };
 
-#endif // MENU_DISPLAY_H
\ No newline at end of file
+#endif // MENU_DISPLAY_H
@@ -0,0 +1,777 @@
+#include "MenuDisplayBase.h"
+#include <string.h>
+
+// Sets the current menu and clears history
+void MenuDisplayBase::setMenu(const MenuItemList& menu) {
+  MenuLockGuard guard(lock);
+  rootMenu->setSubmenu(menu);
+  ++treeGeneration;
+  currentNode = rootMenu;
+  selectedIndex = scrollOffset = 0;
+  menuHistory.clear();
+  fullRedraw = true;
+}
+
+// Navigates one item (one layout row) up in the menu
+void MenuDisplayBase::scrollUp() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::UP);
+  if (!acceptNavigation(-layoutColumns)) return;
+  moveSelection(selectedIndex - layoutColumns, scrollOffset);
+}
+
+// Navigates one item (one layout row) down in the menu
+void MenuDisplayBase::scrollDown() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::DOWN);
+  if (!acceptNavigation(layoutColumns)) return;
+  moveSelection(selectedIndex + layoutColumns, scrollOffset);
+}
+
+// Activates the selected menu item or enters a submenu
+void MenuDisplayBase::select() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::SELECT);
+  if (wake()) return;  // First input only wakes a dimmed or sleeping display
+  if (handleOverlayInput(MenuInput::SELECT)) return;  // Modal overlay took it
+  if (selectedIndex >= 0 && selectedIndex < (int)currentMenu().size()) {
+    auto selected = currentMenu()[selectedIndex];
+    if (selected && selected->hasSubmenu()) {
+      if (menuHistory.size() >= menuHistory.max_size()) return;  // Deeper than the history holds (static profile)
+      menuHistory.push_back({ currentNode, selectedIndex, scrollOffset });
+      enterSubmenu(selected);
+      selectedIndex = scrollOffset = 0;
+    } else if (selected && selected->isTaskRunning()) {
+      selected->cancelTask();  // Second press stops it; refresh() restores the label
+      return;
+    } else if (selected && selected->hasTask()) {
+      if (runningTasks.size() >= runningTasks.max_size()) return;  // MENU_MAX_TASKS running (static profile)
+      if (selected->startTask(millis())) {
+        runningTasks.push_back(selected);  // Stepped by update(), only its row changes
+      }
+      return;
+    } else if (selected) {
+      selected->activate();  // Execute menu action
+    }
+  }
+  manualScrollOffset = 0;
+  fullRedraw = true;
+}
+
+// Returns to the previous menu (if available)
+void MenuDisplayBase::goBack() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::BACK);
+  if (wake()) return;  // First input only wakes a dimmed or sleeping display
+  if (handleOverlayInput(MenuInput::BACK)) return;  // Modal overlay took it
+  if (!menuHistory.empty()) {
+    MenuItemPtr left = currentNode;
+    const MenuHistoryEntry& parent = menuHistory.back();
+    currentNode = parent.node;
+    selectedIndex = parent.selectedIndex;  // Back on the item that was entered
+    scrollOffset = parent.scrollOffset;
+    menuHistory.pop_back();
+    if (evictionPolicy == LazyEvictionPolicy::ON_BACK) {
+      if (left->releaseSubmenu()) {  // Rebuilt by its factory on the next visit
+        ++treeGeneration;
+        untrackLazyMenu(left.get());
+      }
+    }
+    keepSelectionVisible();  // The parent menu may have changed meanwhile
+  }
+  manualScrollOffset = 0;
+  isScrollingManually = false;
+  fullRedraw = true;
+}
+
+// Checks if it's possible to return to a previous menu
+bool MenuDisplayBase::canGoBack() const {
+  MenuLockGuard guard(lock);
+  return !menuHistory.empty();
+}
+
+// Horizontal scrolling controls
+void MenuDisplayBase::scrollLeft() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::LEFT);
+  if (wake()) return;  // First input only wakes a dimmed or sleeping display
+  if (handleOverlayInput(MenuInput::LEFT)) return;  // Modal overlay took it
+  if (layoutColumns > 1) {  // Grid: previous item
+    moveSelection(selectedIndex - 1, scrollOffset);
+    return;
+  }
+   if (manualScrollOffset > 0) {
+    manualScrollOffset = max(manualScrollOffset - charWidth, 0);
+    if (manualScrollOffset == 0) {
+      isScrollingManually = false;
+    }
+    dirtyRows |= (1UL << (selectedIndex - scrollOffset));  // Only the selected row moves
+  }
+  
+}
+
+void MenuDisplayBase::scrollRight() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::RIGHT);
+  if (wake()) return;  // First input only wakes a dimmed or sleeping display
+  if (handleOverlayInput(MenuInput::RIGHT)) return;  // Modal overlay took it
+  if (layoutColumns > 1) {  // Grid: next item
+    moveSelection(selectedIndex + 1, scrollOffset);
+    return;
+  }
+ if (selectedIndex >= 0 && selectedIndex < (int)currentMenu().size()) {
+    const int textWidth = currentMenu()[selectedIndex]->getGlyphs().width();
+    const int availableWidth = displayHSize - prefixWidth - 4; // Account for padding
+    
+    if (textWidth > availableWidth) {
+      isScrollingManually = true;
+      manualScrollOffset = min(
+        manualScrollOffset + charWidth, 
+        textWidth - availableWidth
+      );
+      dirtyRows |= (1UL << (selectedIndex - scrollOffset));  // Only the selected row moves
+    }
+  }
+}
+
+// ========== BULK NAVIGATION ==========
+
+// Moves the selection and the window up by one screen
+void MenuDisplayBase::pageUp() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::PAGE_UP);
+  if (!acceptNavigation(-1)) return;
+  moveSelection(selectedIndex - visibleElements, scrollOffset - visibleElements);
+}
+
+// Moves the selection and the window down by one screen
+void MenuDisplayBase::pageDown() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::PAGE_DOWN);
+  if (!acceptNavigation(1)) return;
+  moveSelection(selectedIndex + visibleElements, scrollOffset + visibleElements);
+}
+
+// Selects the first item
+void MenuDisplayBase::home() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::HOME);
+  if (!acceptNavigation(-1)) return;
+  moveSelection(0, 0);
+}
+
+// Selects the last item, with the window at the end of the menu
+void MenuDisplayBase::end() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::END);
+  if (!acceptNavigation(1)) return;
+  moveSelection(currentMenu().size() - 1, currentMenu().size());
+}
+
+// Selects item 'index', scrolling only as far as needed to show it
+void MenuDisplayBase::jumpTo(int index) {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::JUMP, index);
+  if (index == selectedIndex) return;  // No movement: not an input, the overlay never sees it
+  if (!acceptNavigation(index - selectedIndex)) return;
+  moveSelection(index, scrollOffset);
+}
+
+// Moves the selection by 'steps' items, scrolling only as far as needed
+void MenuDisplayBase::moveBy(int steps) {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::MOVE, steps);
+  if (steps == 0) return;  // No movement: not an input, the overlay never sees it
+  if (!acceptNavigation(steps)) return;
+  moveSelection(selectedIndex + steps, scrollOffset);
+}
+
+// Registers the input; returns false if it only woke the display or an overlay took it
+bool MenuDisplayBase::acceptNavigation(int steps) {
+  if (wake()) return false;  // First input only wakes a dimmed or sleeping display
+  if (handleOverlayInput(steps < 0 ? MenuInput::UP : MenuInput::DOWN)) return false;  // Modal overlay took it
+  return true;
+}
+
+// Clamps 'offset' to whole layout rows without empty rows at the end, then moves it
+// only as far as needed to show item 'index'
+int MenuDisplayBase::windowFor(int index, int offset) const {
+  const int count = currentMenu().size();
+  const int rows = max(1, visibleElements / layoutColumns);
+  const int totalRows = (count + layoutColumns - 1) / layoutColumns;
+
+  int firstRow = constrain(offset, 0, max(0, totalRows - rows) * layoutColumns) / layoutColumns;
+  const int selectedRow = index / layoutColumns;
+  if (selectedRow < firstRow) firstRow = selectedRow;
+  if (selectedRow >= firstRow + rows) firstRow = selectedRow - rows + 1;
+  return firstRow * layoutColumns;
+}
+
+// Places the selection and the window directly and marks the changed rows once
+void MenuDisplayBase::moveSelection(int index, int offset) {
+  const int count = currentMenu().size();
+  if (count == 0) return;
+
+  index = constrain(index, 0, count - 1);
+  offset = windowFor(index, offset);
+  if (index == selectedIndex && offset == scrollOffset) return;
+
+  if (offset == scrollOffset) {
+    invalidateItems(selectedIndex, selectedIndex);  // Old and new selection only
+    invalidateItems(index, index);
+  } else {
+    scrollOffset = offset;
+    invalidateItems(offset, offset + visibleElements - 1);  // Window moved: every row
+  }
+  selectedIndex = index;
+  manualScrollOffset = 0;
+  isScrollingManually = false;
+  scrollbarDirty = true;
+}
+
+// ========== IDLE POWER MANAGEMENT ==========
+
+// Moves to a deeper idle state once its timeout has elapsed
+void MenuDisplayBase::updateIdleState(unsigned long now) {
+  IdleState target = idlePolicy.stateFor(now - lastInputTime);
+  if (target <= idleState) return;  // Only input brings the display back up
+
+  applyIdleState(idleState, target);
+  idleState = target;
+}
+
+// Registers user input and wakes the display up
+bool MenuDisplayBase::wake() {
+  MenuLockGuard guard(lock);
+  lastInputTime = millis();
+  if (idleState == IdleState::ACTIVE) return false;
+
+  // Dimmed or off, the user may not be reading the screen: the input only wakes it.
+  // Throttled, the screen looks as usual and the input is used.
+  const bool unreadable = (idleState >= IdleState::DIMMED);
+  applyIdleState(idleState, IdleState::ACTIVE);
+  idleState = IdleState::ACTIVE;
+  fullRedraw = true;
+
+  if (unreadable) {
+    render();  // Show the current screen right away instead of waiting for update()
+  }
+  return unreadable;
+}
+
+// ========== LAZY SUBMENUS ==========
+
+// Sets the eviction policy and applies it right away
+void MenuDisplayBase::setLazyEvictionPolicy(LazyEvictionPolicy policy, int cacheSize) {
+  MenuLockGuard guard(lock);
+  evictionPolicy = policy;
+  lazyCacheSize = max(0, cacheSize);
+  if (evictionPolicy == LazyEvictionPolicy::LRU) {
+    evictLazyMenus(lazyCacheSize);
+  }
+}
+
+// Releases all built lazy submenus except those on the current path
+void MenuDisplayBase::releaseLazyMenus() {
+  MenuLockGuard guard(lock);
+  evictLazyMenus(0);
+}
+
+// Makes 'node' the displayed menu, building its children first if it is lazy
+void MenuDisplayBase::enterSubmenu(const MenuItemPtr& node) {
+  const bool building = node->isLazy() && node->getSubmenu().empty();
+  node->buildSubmenu();
+  if (building) ++treeGeneration;  // New children for the path index
+  currentNode = node;
+  if (!node->isLazy()) return;
+
+  // Move the node to the most recently used end of the list
+  untrackLazyMenu(node.get());
+  builtLazyMenus.push_back(node);
+
+  if (evictionPolicy == LazyEvictionPolicy::LRU) {
+    evictLazyMenus(lazyCacheSize);
+  }
+}
+
+// Removes 'node' from the list of built lazy submenus
+void MenuDisplayBase::untrackLazyMenu(const MenuItem* node) {
+  for (size_t i = 0; i < builtLazyMenus.size(); ++i) {
+    if (builtLazyMenus[i].lock().get() == node) {
+      builtLazyMenus.erase(builtLazyMenus.begin() + i);
+      return;
+    }
+  }
+}
+
+// Whether 'node' is the displayed menu or one of the menus in the history
+bool MenuDisplayBase::isOnCurrentPath(const MenuItem* node) const {
+  if (node == currentNode.get()) return true;
+  for (const auto& entry : menuHistory) {
+    if (entry.node.get() == node) return true;
+  }
+  return false;
+}
+
+// Releases the least recently entered lazy submenus until at most 'keep' remain
+// (not counting those on the current path, which are never released)
+void MenuDisplayBase::evictLazyMenus(size_t keep) {
+  size_t evictable = 0;
+  for (size_t i = 0; i < builtLazyMenus.size();) {
+    MenuItemPtr node = builtLazyMenus[i].lock();
+    if (!node) {
+      builtLazyMenus.erase(builtLazyMenus.begin() + i);  // Removed from the tree meanwhile
+      continue;
+    }
+    if (!isOnCurrentPath(node.get())) ++evictable;
+    ++i;
+  }
+
+  for (size_t i = 0; i < builtLazyMenus.size() && evictable > keep;) {
+    MenuItemPtr node = builtLazyMenus[i].lock();
+    if (node && !isOnCurrentPath(node.get())) {
+      if (node->releaseSubmenu()) ++treeGeneration;
+      builtLazyMenus.erase(builtLazyMenus.begin() + i);
+      --evictable;
+    } else {
+      ++i;
+    }
+  }
+}
+
+// ========== NAVIGATION STATE (FAST RESUME) ==========
+
+// Captures the path from the root to the current menu
+NavigationState MenuDisplayBase::getNavigationState() const {
+  MenuLockGuard guard(lock);
+  NavigationState state;
+  state.depth = min((int)menuHistory.size(), MAX_NAVIGATION_DEPTH);
+  for (int level = 0; level < state.depth; ++level) {
+    state.path[level] = min(menuHistory[level].selectedIndex, 255);
+    state.scroll[level] = min(menuHistory[level].scrollOffset, 255);
+  }
+  if ((int)menuHistory.size() > state.depth) {
+    // Deeper than a state can hold: resume on the item entered at the last saved level
+    state.selectedIndex = min(menuHistory[state.depth].selectedIndex, 255);
+    state.scrollOffset = min(menuHistory[state.depth].scrollOffset, 255);
+  } else {
+    state.selectedIndex = min(selectedIndex, 255);
+    state.scrollOffset = min(scrollOffset, 255);
+  }
+  return state;
+}
+
+// Re-enters the saved submenus from the root, touching only the nodes on the path
+bool MenuDisplayBase::restoreNavigationState(const NavigationState& state) {
+  MenuLockGuard guard(lock);
+  menuHistory.clear();
+  currentNode = rootMenu;
+
+  int level = 0;
+  for (; level < state.depth; ++level) {
+    const int index = state.path[level];
+    if (index >= (int)currentMenu().size() || !currentMenu()[index]->hasSubmenu()) break;
+    menuHistory.push_back({ currentNode, index, state.scroll[level] });
+    enterSubmenu(currentMenu()[index]);
+  }
+
+  const bool complete = (level == state.depth);
+  if (complete) {
+    selectedIndex = state.selectedIndex;
+    scrollOffset = state.scrollOffset;
+  } else {
+    selectedIndex = state.path[level];  // Point at the submenu that could not be entered
+    scrollOffset = state.scroll[level];
+  }
+  manualScrollOffset = 0;
+  isScrollingManually = false;
+  keepSelectionVisible();
+  fullRedraw = true;
+  return complete;
+}
+
+// Serializes the current position and hands it to 'store'
+bool MenuDisplayBase::saveNavigation(NavigationStore& store) const {
+  uint8_t buffer[NavigationState::MAX_SIZE];
+  size_t size = getNavigationState().serialize(buffer, sizeof(buffer));
+  return size > 0 && store.save(buffer, size);
+}
+
+// Loads a position from 'store' and restores it; returns false if nothing valid was stored
+bool MenuDisplayBase::restoreNavigation(NavigationStore& store) {
+  uint8_t buffer[NavigationState::MAX_SIZE];
+  NavigationState state;
+  size_t size = store.load(buffer, sizeof(buffer));
+  if (!state.deserialize(buffer, size)) return false;
+  return restoreNavigationState(state);
+}
+
+// ========== PATH NAVIGATION ==========
+
+// Jumps to the item named by 'path', e.g. "Settings/WiFi/Scanner"
+bool MenuDisplayBase::navigateTo(const char* path, bool open) {
+  if (!path || !*path) return false;  // Names no item
+  MenuLockGuard guard(lock);
+  const MenuPathId id = MenuIndex::hash(path);
+  TraceScope traced(*this, TraceEvent::NAVIGATE, (int32_t)id, open, path);
+
+  int route[MAX_NAVIGATION_DEPTH + 1];
+  int levels = 0;
+  if (!findRoute(id, route, levels) && !walkPath(path, route, levels)) return false;
+  wake();  // A deep link takes effect even if the display was off
+  followRoute(route, levels, open);
+  return true;
+}
+
+// Jumps to the item whose path has the id 'id' (see menuPathId())
+bool MenuDisplayBase::navigateTo(MenuPathId id, bool open) {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::NAVIGATE, (int32_t)id, open);
+
+  int route[MAX_NAVIGATION_DEPTH + 1];
+  int levels = 0;
+  if (!findRoute(id, route, levels)) return false;
+  wake();  // A deep link takes effect even if the display was off
+  followRoute(route, levels, open);
+  return true;
+}
+
+// Hashes the labels of the entered items and of the selected one
+MenuPathId MenuDisplayBase::getSelectedPathId() const {
+  MenuLockGuard guard(lock);
+  MenuPathId id = MENU_PATH_ROOT;
+  bool topLevel = true;
+  for (const MenuHistoryEntry& entry : menuHistory) {
+    const MenuItemList& items = entry.node->getSubmenu();
+    if (entry.selectedIndex >= (int)items.size()) break;  // Changed since it was entered
+    id = MenuIndex::append(id, items[entry.selectedIndex]->getLabelText(), topLevel);
+    topLevel = false;
+  }
+  if (selectedIndex < (int)currentMenu().size()) {
+    id = MenuIndex::append(id, currentMenu()[selectedIndex]->getLabelText(), topLevel);
+  }
+  return id;
+}
+
+// Labels are part of the ids, so a language switch changes them too
+uint32_t MenuDisplayBase::treeVersion() const {
+  return ((uint32_t)treeGeneration << 16) | MenuStrings::getGeneration();
+}
+
+// Looks 'id' up in the index, rebuilding it first if the tree changed, and checks the
+// result against the tree. A miss costs one lookup, never a walk of the tree.
+bool MenuDisplayBase::findRoute(MenuPathId id, int* route, int& levels) {
+  levels = 0;
+  if (id == MENU_PATH_ROOT) return true;
+
+  const uint32_t version = treeVersion();
+  if (!pathIndex.isCurrent(version)) pathIndex.build(*rootMenu, version);
+  levels = pathIndex.find(id, route);
+  if (levels == 0) return false;
+  if (routeMatches(id, route, levels)) return true;
+
+  // The route no longer leads there: the tree was changed directly through MenuItem
+  pathIndex.build(*rootMenu, version);
+  levels = pathIndex.find(id, route);
+  return levels > 0 && routeMatches(id, route, levels);
+}
+
+// Finds each label of 'path' among the children of the previous one. Lazy submenus on
+// the way are built; they are released again if the path does not exist.
+bool MenuDisplayBase::walkPath(const char* path, int* route, int& levels) {
+  MenuItem* built[MAX_NAVIGATION_DEPTH];
+  int builtCount = 0;
+  MenuItem* node = rootMenu.get();
+  levels = 0;
+
+  for (const char* segment = path;;) {
+    const char* slash = strchr(segment, '/');
+    const size_t length = slash ? (size_t)(slash - segment) : strlen(segment);
+
+    const MenuItemList& items = node->getSubmenu();
+    int found = -1;
+    for (size_t i = 0; i < items.size() && found < 0; ++i) {
+      const char* label = items[i] ? items[i]->getLabelText() : "";
+      if (items[i] && strncmp(label, segment, length) == 0 && label[length] == '\0') found = i;
+    }
+    if (found < 0) break;
+
+    route[levels++] = found;
+    node = items[found].get();
+    if (!slash) {
+      if (builtCount > 0) ++treeGeneration;
+      return true;
+    }
+    if (levels > MAX_NAVIGATION_DEPTH) break;  // Deeper than the history can hold
+
+    if (node->isLazy() && node->getSubmenu().empty()) {
+      node->buildSubmenu();  // Entered by followRoute(), which tracks it for eviction
+      built[builtCount++] = node;
+    }
+    segment = slash + 1;
+  }
+
+  if (builtCount > 0) ++treeGeneration;  // Released again, but the static profile keeps them
+  while (builtCount > 0) built[--builtCount]->releaseSubmenu();
+  return false;
+}
+
+// Whether following 'route' in the current tree reaches an item whose path has the id 'id'
+bool MenuDisplayBase::routeMatches(MenuPathId id, const int* route, int levels) const {
+  const MenuItem* node = rootMenu.get();
+  MenuPathId hash = MENU_PATH_ROOT;
+  for (int level = 0; level < levels; ++level) {
+    const MenuItemList& items = node->getSubmenu();
+    if (route[level] >= (int)items.size() || !items[route[level]]) return false;
+    node = items[route[level]].get();
+    hash = MenuIndex::append(hash, node->getLabelText(), level == 0);
+  }
+  return hash == id;
+}
+
+// Enters the submenus of 'route' from the root, as select() would, and selects its
+// last item with the window placed as jumpTo() would; the screen is repainted once
+void MenuDisplayBase::followRoute(const int* route, int levels, bool open) {
+  menuHistory.clear();
+  currentNode = rootMenu;
+  for (int level = 0; level + 1 < levels; ++level) {
+    menuHistory.push_back({ currentNode, route[level], windowFor(route[level], 0) });
+    enterSubmenu(currentMenu()[route[level]]);
+  }
+
+  selectedIndex = (levels > 0) ? route[levels - 1] : 0;
+  scrollOffset = windowFor(selectedIndex, 0);
+  if (open && levels > 0 && levels <= MAX_NAVIGATION_DEPTH && currentMenu()[selectedIndex]->hasSubmenu()) {
+    menuHistory.push_back({ currentNode, selectedIndex, scrollOffset });
+    enterSubmenu(currentMenu()[selectedIndex]);
+    selectedIndex = scrollOffset = 0;
+  }
+  manualScrollOffset = 0;
+  isScrollingManually = false;
+  fullRedraw = true;
+}
+
+// ========== RUNTIME MENU CHANGES ==========
+
+// Whether 'parent' (nullptr = root) is the menu currently on screen
+bool MenuDisplayBase::isCurrentMenu(const MenuItemPtr& parent) const {
+  return (parent ? parent : rootMenu) == currentNode;
+}
+
+// Marks the visible rows showing items first..last (inclusive) as dirty
+void MenuDisplayBase::invalidateItems(int first, int last) {
+  first = max(first, scrollOffset);
+  last = min(last, scrollOffset + visibleElements - 1);
+  for (int idx = first; idx <= last; ++idx) {
+    dirtyRows |= (1UL << (idx - scrollOffset));
+  }
+}
+
+// Keeps the selection in range and inside the scroll window after the item count changed
+void MenuDisplayBase::keepSelectionVisible() {
+  const int count = currentMenu().size();
+  const int oldOffset = scrollOffset;
+
+  selectedIndex = constrain(selectedIndex, 0, max(0, count - 1));
+  scrollOffset = windowFor(selectedIndex, scrollOffset);
+
+  if (scrollOffset != oldOffset) {
+    invalidateItems(scrollOffset, scrollOffset + visibleElements - 1);  // Whole window shifted
+  }
+  scrollbarDirty = true;
+}
+
+// Inserts 'item' at 'index' of the submenu of 'parent'
+bool MenuDisplayBase::insertItem(const MenuItemPtr& parent, int index, const MenuItemPtr& item) {
+  MenuLockGuard guard(lock);
+  MenuItem& node = parent ? *parent : *rootMenu;
+  const bool hadScrollbar = (int)node.getSubmenu().size() > visibleElements;
+  if (!node.insertSubmenuItem(index, item)) return false;
+  ++treeGeneration;
+  if (!isCurrentMenu(parent)) return true;
+
+  if (hadScrollbar != ((int)currentMenu().size() > visibleElements)) {
+    fullRedraw = true;  // Row width changes with the scrollbar
+  }
+  if (index <= selectedIndex && currentMenu().size() > 1) {
+    selectedIndex++;  // Keep the same item selected
+  }
+  if (index < scrollOffset) {
+    scrollOffset++;   // Inserted above the window: visible rows stay the same
+  } else {
+    invalidateItems(index, scrollOffset + visibleElements - 1);
+  }
+  keepSelectionVisible();
+  return true;
+}
+
+// Appends 'item' to the submenu of 'parent'
+bool MenuDisplayBase::appendItem(const MenuItemPtr& parent, const MenuItemPtr& item) {
+  MenuLockGuard guard(lock);
+  MenuItem& node = parent ? *parent : *rootMenu;
+  return insertItem(parent, node.getSubmenu().size(), item);
+}
+
+// Removes the item at 'index' of the submenu of 'parent'
+bool MenuDisplayBase::removeItem(const MenuItemPtr& parent, int index) {
+  MenuLockGuard guard(lock);
+  MenuItem& node = parent ? *parent : *rootMenu;
+  const bool hadScrollbar = (int)node.getSubmenu().size() > visibleElements;
+  if (!node.removeSubmenuItem(index)) return false;
+  ++treeGeneration;
+  if (!isCurrentMenu(parent)) return true;
+
+  if (hadScrollbar != ((int)currentMenu().size() > visibleElements)) {
+    fullRedraw = true;
+  }
+  if (index < selectedIndex) {
+    selectedIndex--;  // Keep the same item selected
+  } else if (index == selectedIndex) {
+    manualScrollOffset = 0;  // The next item takes the selection
+    isScrollingManually = false;
+  }
+  if (index < scrollOffset) {
+    scrollOffset--;
+  } else {
+    invalidateItems(index, scrollOffset + visibleElements - 1);
+  }
+  keepSelectionVisible();
+  return true;
+}
+
+// Replaces the item at 'index' of the submenu of 'parent'
+bool MenuDisplayBase::replaceItem(const MenuItemPtr& parent, int index, const MenuItemPtr& item) {
+  MenuLockGuard guard(lock);
+  MenuItem& node = parent ? *parent : *rootMenu;
+  if (!node.replaceSubmenuItem(index, item)) return false;
+  ++treeGeneration;
+  if (!isCurrentMenu(parent)) return true;
+
+  if (index == selectedIndex) {
+    manualScrollOffset = 0;
+    isScrollingManually = false;
+  }
+  invalidateItems(index, index);
+  return true;
+}
+
+// Moves the item at 'from' to 'to' in the submenu of 'parent'
+bool MenuDisplayBase::moveItem(const MenuItemPtr& parent, int from, int to) {
+  MenuLockGuard guard(lock);
+  MenuItem& node = parent ? *parent : *rootMenu;
+  if (!node.moveSubmenuItem(from, to)) return false;
+  ++treeGeneration;
+  if (!isCurrentMenu(parent) || from == to) return true;
+
+  // Follow the selected item to its new index
+  if (selectedIndex == from) {
+    selectedIndex = to;
+  } else if (from < selectedIndex && to >= selectedIndex) {
+    selectedIndex--;
+  } else if (from > selectedIndex && to <= selectedIndex) {
+    selectedIndex++;
+  }
+  invalidateItems(min(from, to), max(from, to));
+  keepSelectionVisible();
+  return true;
+}
+
+// Label widths change with the language, so the whole menu is repainted
+// and horizontal scrolling starts over
+void MenuDisplayBase::refreshStrings() {
+  if (stringGeneration == MenuStrings::getGeneration()) return;
+  stringGeneration = MenuStrings::getGeneration();
+  manualScrollOffset = 0;
+  isScrollingManually = false;
+  fullRedraw = true;
+}
+
+// Polls the live items on the visible rows and marks the rows whose text changed
+void MenuDisplayBase::refreshLiveItems() {
+  const unsigned long now = millis();
+  for (int i = 0; i < visibleElements; ++i) {
+    int idx = scrollOffset + i;
+    if (idx >= (int)currentMenu().size()) break;
+    if (currentMenu()[idx]->refresh(now)) {
+      dirtyRows |= (1UL << i);
+    }
+  }
+}
+
+// ========== BACKGROUND TASKS ==========
+
+// Whether any task is running
+bool MenuDisplayBase::hasRunningTasks() const {
+  MenuLockGuard guard(lock);
+  return !runningTasks.empty();
+}
+
+// Cancels every running task
+void MenuDisplayBase::cancelTasks() {
+  MenuLockGuard guard(lock);
+  MenuVector<MenuItemPtr, MENU_MAX_TASKS> cancelled;
+  cancelled.swap(runningTasks);  // The cleanup steps may start or cancel tasks themselves
+  for (auto& task : cancelled) {
+    task->cancelTask();
+  }
+}
+
+// Steps the running tasks in turn until the frame budget is spent
+void MenuDisplayBase::runTasks() {
+  const unsigned long start = micros();
+  while (!runningTasks.empty()) {
+    // A step may change the list (e.g. call cancelTasks() or select()), so step a copy
+    const MenuVector<MenuItemPtr, MENU_MAX_TASKS> tasks = runningTasks;
+    for (const MenuItemPtr& task : tasks) {
+      if (task->stepTask()) continue;
+      for (size_t i = 0; i < runningTasks.size(); ++i) {  // Finished or cancelled
+        if (runningTasks[i] == task) {
+          runningTasks.erase(runningTasks.begin() + i);
+          break;
+        }
+      }
+    }
+    if (micros() - start >= taskBudget) break;
+  }
+}
+
+// ========== INPUT TRACE ==========
+
+// Starts or stops recording
+void MenuDisplayBase::setInputTrace(InputTraceRecorder* recorder) {
+  MenuLockGuard guard(lock);
+  trace = recorder;
+  if (trace) trace->start(millis());
+}
+
+// Records a status bar element change
+void MenuDisplayBase::traceStatus(uint8_t element, int32_t value) {
+  MenuLockGuard guard(lock);
+  if (trace && !tracing) trace->record(millis(), TraceEvent::STATUS, value, element);
+}
+
+// Forces a full repaint on the next update()
+void MenuDisplayBase::invalidate() {
+  MenuLockGuard guard(lock);
+  TraceScope traced(*this, TraceEvent::INVALIDATE);
+  fullRedraw = true;
+}
+
+MenuDisplayBase::TraceScope::TraceScope(MenuDisplayBase& menu, TraceEvent event, int32_t value, uint8_t element,
+                                        const char* path)
+  : menu(menu), event(event), value(value), element(element), path(path), outer(menu.trace && !menu.tracing) {
+  if (!outer) return;
+  menu.tracing = true;
+  time = millis();
+  frameCount = menu.frameCount;
+  idleState = menu.idleState;
+}
+
+MenuDisplayBase::TraceScope::~TraceScope() {
+  if (!outer) return;
+  menu.tracing = false;
+  if (event == TraceEvent::UPDATE && menu.frameCount == frameCount && menu.idleState == idleState) {
+    return;  // Nothing happened, replaying it would not change anything
+  }
+  menu.trace->record(time, event, value, element, path);
+}
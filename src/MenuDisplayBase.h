@@ -0,0 +1,364 @@
+// Header guard to prevent multiple inclusions
+#ifndef MENU_DISPLAY_BASE_H
+#define MENU_DISPLAY_BASE_H
+
+// Include necessary libraries
+#include "MenuConfig.h"        // Build profile: containers and smart pointers
+#include "MenuItem.h"          // Menu item class
+#include "LazyMenuItem.h"      // Lazy submenu eviction policy
+#include "MenuLock.h"          // Lock for changes from other tasks
+#include "IdlePolicy.h"        // Idle power management settings
+#include "NavigationStore.h"   // Saving/restoring the navigation state
+#include "MenuInput.h"         // Navigation input codes
+#include "InputTrace.h"        // Recording of navigation inputs and frames
+#include "MenuIndex.h"         // Path ids and the index used by navigateTo()
+#include <Arduino.h>
+
+// Maximum number of visible menu cells (one bit per cell in the dirty-row mask)
+#define MAX_VISIBLE_ROWS 32
+
+// A menu left by entering one of its submenus
+struct MenuHistoryEntry {
+  MenuItemPtr node;  // Node whose submenu was displayed
+  int selectedIndex;               // Item that was entered
+  int scrollOffset;                // Scroll position at that time
+};
+
+// Menu state and navigation, independent of the display type.
+// Rendering lives in MenuDisplay (see MenuDisplay.h).
+class MenuDisplayBase {
+protected:
+  int elementSpacing = 2;  // Pixel spacing between status bar elements
+
+  // Menu system configuration
+  MenuItemPtr rootMenu = makeMenuObject<MenuItem>("");  // Holds the items passed to setMenu()
+  MenuItemPtr currentNode = rootMenu;  // Node whose submenu is currently displayed
+  MenuVector<MenuHistoryEntry, MAX_NAVIGATION_DEPTH> menuHistory;  // Menu navigation history stack (back = top)
+  int selectedIndex = 0;    // Index of currently selected menu item
+  int scrollOffset = 0;     // Vertical scroll position for long menus
+  int visibleElements = 5;  // Number of visible menu items at once (cells of the layout)
+  int visibleRows = 5;      // Rows requested with setVisibleElements()
+  int layoutColumns = 1;    // Items per row of the layout (1 = list)
+  bool layoutDirty = true;  // Whether the layout's cell table must be recomputed
+
+  // Horizontal scrolling control
+  int manualScrollOffset = 0;       // Current horizontal scroll offset
+  bool isScrollingManually = false; // Whether manual scrolling is active
+  const int charWidth = 6;          // Monospace character width (pixels)
+  const int prefixWidth = 12;       // Width for "> " prefix before selected item
+
+  // Top bar customization options
+  int statusBarBgColor = 1;    // Status bar background color (0/1 for monochrome)
+  int statusBarHeight = 13;    // Status bar height in pixels
+  bool showStatusBar = true;   // Whether to show status bar
+
+  // Display dimensions (default 128x64)
+  int displayVSize = 64;    // Vertical size (height)
+  int displayHSize = 128;   // Horizontal size (width)
+
+  // Display control flag
+  bool renderDisplay = true;  // Whether to render the display
+
+  // Invalidation state used by update()
+  bool fullRedraw = true;     // Whether the whole screen must be repainted
+  uint32_t dirtyRows = 0;     // Bit i set = visible cell i must be repainted
+  bool scrollbarDirty = false; // Whether the scroll indicator must be cleared and repainted
+  uint16_t stringGeneration = 0; // MenuStrings generation of the last frame (language check)
+
+  // Lazy submenus
+  LazyEvictionPolicy evictionPolicy = LazyEvictionPolicy::NEVER;  // When built lazy submenus are released
+  int lazyCacheSize = 2;  // Built lazy submenus kept with the LRU policy
+  MenuVector<MenuWeakPtr<MenuItem>, MENU_MAX_LAZY_MENUS> builtLazyMenus;  // Built lazy submenus, most recently entered last
+
+  // Idle power management
+  IdlePolicy idlePolicy;                    // Timeouts for throttling, dimming and sleep
+  IdleState idleState = IdleState::ACTIVE;  // Current power state of the display
+  unsigned long lastInputTime = 0;          // Time of the last user input (ms)
+  unsigned long lastFrameTime = 0;          // Time of the last frame sent to the display (ms)
+  unsigned long frameCount = 0;             // Frames sent to the display
+
+  // Background tasks (TaskMenuItem)
+  MenuVector<MenuItemPtr, MENU_MAX_TASKS> runningTasks;  // Started and not finished, in start order
+  unsigned long taskBudget = 5000;  // Time given to tasks per update() (us)
+
+  // Path navigation
+  MenuIndex pathIndex;  // Path ids of the tree, built by navigateTo() when the tree changed
+  uint16_t treeGeneration = 0;  // Bumped by every change of the tree made through this class
+
+  // Input trace
+  InputTraceRecorder* trace = nullptr;  // Receives the calls, nullptr = not recording
+  bool tracing = false;                 // Inside a recorded call
+
+  // Guards the menu tree and navigation state against concurrent changes
+  mutable MenuLock lock;
+
+public:
+  virtual ~MenuDisplayBase() = default;
+
+  // ========== STATUS BAR CONFIGURATION ==========
+
+  // Set spacing between status bar elements
+  void setElementSpacing(int spacing) {
+    MenuLockGuard guard(lock);
+    elementSpacing = spacing;
+    fullRedraw = true;
+  }
+
+  // Set status bar background color
+  void setStatusBarBackgroundColor(int color) {
+    MenuLockGuard guard(lock);
+    statusBarBgColor = color;
+    fullRedraw = true;
+  }
+
+  // Get current status bar color
+  int getStatusBarBackgroundColor() {
+    MenuLockGuard guard(lock);
+    return statusBarBgColor;
+  }
+
+  // Set status bar height
+  void setStatusBarHeight(int height) {
+    MenuLockGuard guard(lock);
+    statusBarHeight = height;
+    layoutDirty = fullRedraw = true;
+  }
+
+  // Show/hide status bar
+  void setShowStatusBar(bool show) {
+    MenuLockGuard guard(lock);
+    showStatusBar = show;
+    layoutDirty = fullRedraw = true;
+  }
+
+  // ========== DISPLAY CONFIGURATION ==========
+
+  // Set display dimensions
+  void setDisplaySize(int width, int height) {
+    MenuLockGuard guard(lock);
+    displayHSize = width;
+    displayVSize = height;
+    layoutDirty = fullRedraw = true;
+  }
+
+  // Enable/disable display rendering
+  void setRenderDisplay(bool isRender) {
+    MenuLockGuard guard(lock);
+    renderDisplay = isRender;
+  }
+
+  // Check if rendering is enabled
+  bool isRenderDisplay() {
+    MenuLockGuard guard(lock);
+    return renderDisplay;
+  }
+
+  // ========== IDLE POWER MANAGEMENT ==========
+
+  // Sets the timeouts after which the display is throttled, dimmed and switched off
+  void setIdlePolicy(const IdlePolicy& policy) {
+    MenuLockGuard guard(lock);
+    idlePolicy = policy;
+  }
+
+  // Returns the current power state of the display
+  IdleState getIdleState() const {
+    MenuLockGuard guard(lock);
+    return idleState;
+  }
+
+  // Registers user activity and restores full brightness and frame rate.
+  // Navigation methods call this themselves; call it for other inputs (e.g. touch).
+  // Returns true if the display was dimmed or off, in which case the input should be ignored.
+  bool wake();
+
+  // ========== MENU MANAGEMENT METHODS ==========
+
+  // Core menu functions
+  void setMenu(const MenuItemList& menu);  // Set active menu
+  void scrollUp();      // Move selection up (one row in grid layouts)
+  void scrollDown();    // Move selection down
+  void scrollLeft();    // Scroll text left (for long items); previous item in grid layouts
+  void scrollRight();   // Scroll text right (for long items); next item in grid layouts
+  void select();        // Activate selected item
+  void goBack();        // Return to previous menu, on the item that was entered
+  bool canGoBack() const;  // Check if back navigation is possible
+
+  // ========== BULK NAVIGATION ==========
+  // Each call places the selection and the scroll window directly and marks the
+  // affected rows once, however far it moves (e.g. several encoder detents per frame).
+
+  void pageUp();            // Move selection up by one screen
+  void pageDown();          // Move selection down by one screen
+  void home();              // Select the first item
+  void end();               // Select the last item
+  void jumpTo(int index);   // Select item 'index' (clamped to the menu); the selected index does nothing
+  void moveBy(int steps);   // Move selection by 'steps' items, negative = up; 0 does nothing
+
+  // Returns the index of the selected item in the displayed menu
+  int getSelectedIndex() const {
+    MenuLockGuard guard(lock);
+    return selectedIndex;
+  }
+
+  // ========== PATH NAVIGATION ==========
+  // Deep links for remote consoles and test tools. An item is named by its path, the
+  // labels (in the active language) from the root menu joined with '/', e.g.
+  // "Settings/WiFi/Scanner", or by the id of that path, menuPathId("Settings/WiFi/Scanner").
+  // The submenus on the way are entered with the history set as if the user had walked
+  // there, the item is selected and scrolled into view, and update() draws one frame.
+  // Ids are looked up in a hash index of the tree, rebuilt on the first call after the
+  // menu or the language changed. Ids of items added directly through MenuItem (not with
+  // the methods of this class) are found after the next change made here. Paths into
+  // lazy submenus that are not built yet are resolved label by label (building them);
+  // ids only reach built submenus. With 'open', an item with a submenu is entered as
+  // well. Returns false, changing nothing (not even waking the display), if no item
+  // matches or 'path' is null or empty. Input traces record the path, not only its id.
+
+  bool navigateTo(const char* path, bool open = false);
+  bool navigateTo(MenuPathId id, bool open = false);
+
+  // Returns the id of the selected item's path (MENU_PATH_ROOT in an empty root menu)
+  MenuPathId getSelectedPathId() const;
+
+  // ========== LAZY SUBMENUS ==========
+
+  // Sets when the children of lazy submenus (LazyMenuItem) are released.
+  // With LRU, at most 'cacheSize' built submenus are kept besides those on the current path.
+  void setLazyEvictionPolicy(LazyEvictionPolicy policy, int cacheSize = 2);
+
+  // Releases every built lazy submenu that is not on the current path (e.g. when the heap runs low)
+  void releaseLazyMenus();
+
+  // ========== BACKGROUND TASKS ==========
+  // Selecting a TaskMenuItem starts its task; update() then runs its steps until the
+  // budget of the frame is spent, so input and rendering are never blocked for long.
+  // Selecting a running task item again cancels it.
+
+  // Sets the time given to running tasks per update() (us). At least one step of
+  // each task runs per frame, however long it takes.
+  void setTaskBudget(unsigned long micros) {
+    MenuLockGuard guard(lock);
+    taskBudget = micros;
+  }
+
+  bool hasRunningTasks() const;  // Whether any task is running
+  void cancelTasks();            // Cancel every running task
+
+  // ========== INPUT TRACE ==========
+  // Records navigation inputs, invalidate() and frames with their times, so that a
+  // session can be replayed on the host (see extras/TraceReplay).
+
+  // Starts recording into 'recorder' (nullptr = stop); writes the trace header
+  void setInputTrace(InputTraceRecorder* recorder);
+
+  // Records that status bar element 'element' (numbered by the application) changed to
+  // 'value', e.g. a battery level; the replay tool applies it to its own elements
+  void traceStatus(uint8_t element, int32_t value);
+
+  // ========== NAVIGATION STATE (FAST RESUME) ==========
+  // The state is the path of entered submenus plus the selection and scroll of
+  // each level. Restoring only walks the nodes on that path, so the rest of the
+  // tree can be built (e.g. with appendItem()) after the first frame.
+
+  NavigationState getNavigationState() const;  // Current position in the menu tree
+
+  // Moves to 'state'. If the tree is shallower than the saved path (e.g. a list that
+  // is not populated yet), stops at the deepest existing level and returns false.
+  bool restoreNavigationState(const NavigationState& state);
+
+  bool saveNavigation(NavigationStore& store) const;  // Serialize and store the current position
+  bool restoreNavigation(NavigationStore& store);     // Load and restore a stored position
+
+  // ========== RUNTIME MENU CHANGES ==========
+  // 'parent' is the node whose submenu changes (nullptr = the menu passed to setMenu()).
+  // The selected item and the scroll window stay where they are, only the affected
+  // rows are repainted by update(). Safe to call from another task.
+  // Each method returns false if an index is out of range.
+
+  bool insertItem(const MenuItemPtr& parent, int index, const MenuItemPtr& item);
+  bool appendItem(const MenuItemPtr& parent, const MenuItemPtr& item);
+  bool removeItem(const MenuItemPtr& parent, int index);
+  bool replaceItem(const MenuItemPtr& parent, int index, const MenuItemPtr& item);
+  bool moveItem(const MenuItemPtr& parent, int from, int to);
+
+  // Set number of visible menu rows (grid layouts have their own row count)
+  void setVisibleElements(int count) {
+    MenuLockGuard guard(lock);
+    visibleRows = constrain(count, 1, MAX_VISIBLE_ROWS);  // Ensure at least 1 item is visible
+    layoutDirty = fullRedraw = true;
+  }
+
+  // Main rendering function, implemented by MenuDisplay
+  virtual void render() = 0;  // Render entire display
+
+  // Forces the next update() to repaint the whole screen (e.g. after a status bar change)
+  void invalidate();
+
+protected:
+  // Records one call in the input trace. Calls made from inside it, e.g. an action
+  // calling goBack() or update() calling render(), belong to it and are not recorded.
+  // UPDATE is only recorded if a frame was sent or the idle state changed.
+  class TraceScope {
+  public:
+    TraceScope(MenuDisplayBase& menu, TraceEvent event, int32_t value = 0, uint8_t element = 0,
+               const char* path = nullptr);
+    ~TraceScope();
+
+  private:
+    MenuDisplayBase& menu;
+    TraceEvent event;
+    int32_t value;
+    uint8_t element;
+    const char* path;           // NAVIGATE: the argument of navigateTo(), nullptr = an id
+    bool outer;                 // Outermost recorded call
+    unsigned long time;         // millis() when the call started
+    unsigned long frameCount;   // Frames sent before the call
+    IdleState idleState;        // Idle state before the call
+  };
+
+  // Sends the display commands (contrast, power) for an idle state change
+  virtual void applyIdleState(IdleState from, IdleState to) = 0;
+
+  // Offers navigation input to the top overlay; returns true if it was consumed
+  virtual bool handleOverlayInput(MenuInput input) { return false; }
+
+  void refreshLiveItems();                  // Poll visible live items, mark changed rows dirty
+  void refreshStrings();                    // Repaint everything after a language switch
+  void runTasks();                          // Step the running tasks within the frame budget
+  void updateIdleState(unsigned long now);  // Apply the idle policy for the time since the last input
+
+  // Items of the currently displayed menu
+  const MenuItemList& currentMenu() const {
+    return currentNode->getSubmenu();
+  }
+
+  // ========== PRIVATE LAZY SUBMENU HELPERS ==========
+
+  void enterSubmenu(const MenuItemPtr& node);  // Build (if lazy) and enter a submenu
+  void untrackLazyMenu(const MenuItem* node);                // Forget a released lazy submenu
+  bool isOnCurrentPath(const MenuItem* node) const;          // Whether 'node' is displayed or in the history
+  void evictLazyMenus(size_t keep);                          // Release LRU submenus until 'keep' remain
+
+  // ========== PRIVATE CHANGE HELPERS ==========
+
+  bool isCurrentMenu(const MenuItemPtr& parent) const;  // Whether 'parent' is displayed
+  void invalidateItems(int first, int last);  // Mark rows showing items first..last dirty
+  void keepSelectionVisible();                // Clamp selection/scroll after the item count changed
+  int windowFor(int index, int offset) const; // Scroll offset near 'offset' that shows item 'index'
+
+  // ========== PRIVATE PATH HELPERS ==========
+
+  uint32_t treeVersion() const;  // Tree generation and language, the state the index is built for
+  bool findRoute(MenuPathId id, int* route, int& levels);         // Look 'id' up in the index
+  bool walkPath(const char* path, int* route, int& levels);       // Match 'path' label by label
+  bool routeMatches(MenuPathId id, const int* route, int levels) const;  // Whether the live tree has 'id' there
+  void followRoute(const int* route, int levels, bool open);      // Enter the levels and select the item
+
+  // ========== PRIVATE NAVIGATION HELPERS ==========
+
+  bool acceptNavigation(int steps);             // Wake and overlay handling for a move by 'steps'
+  void moveSelection(int index, int offset);    // Select 'index' with the window at 'offset', mark rows dirty
+};
+
+#endif // MENU_DISPLAY_BASE_H
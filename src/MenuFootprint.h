@@ -0,0 +1,67 @@
+#ifndef MENU_FOOTPRINT_H
+#define MENU_FOOTPRINT_H
+
+#include "MenuDisplay.h"
+#include "LiveMenuItem.h"
+#include "LazyMenuItem.h"
+#include "TaskMenuItem.h"
+
+// Static RAM taken by the menu and its display driver 'Driver' with the current build
+// profile and capacities (bytes), known at compile time, e.g.
+//   static_assert(MenuFootprintT<DisplaySH1106>::fitsRam(384), "menu does not fit");
+// The font, glyph and sprite tables are PROGMEM and take flash only; flash is reported
+// by the toolchain (avr-size, or the IDE after compiling).
+template <class Driver>
+struct MenuFootprintT {
+  static constexpr size_t ITEM = sizeof(MenuItem);            // One plain item
+  static constexpr size_t LIVE_ITEM = sizeof(LiveMenuItem);   // One live-value item
+  static constexpr size_t LAZY_ITEM = sizeof(LazyMenuItem);   // One lazy submenu item
+  static constexpr size_t TASK_ITEM = sizeof(TaskMenuItem);   // One background task item
+  static constexpr size_t DISPLAY = sizeof(MenuDisplay);  // The menu renderer and its state
+  static constexpr size_t ARENA = MENU_STATIC_PROFILE ? MENU_ARENA_SIZE : 0;  // Item storage (static profile)
+  static constexpr size_t DRIVER = sizeof(Driver);  // The display driver with its frame buffer (e.g. 1 KB for DisplaySH1106)
+  static constexpr size_t TOTAL = DISPLAY + ARENA + DRIVER;
+
+  // RAM of the board (bytes), 0 where the toolchain does not tell (AVR does)
+#if defined(RAMEND) && defined(RAMSTART)
+  static constexpr size_t RAM = RAMEND - RAMSTART + 1;
+#else
+  static constexpr size_t RAM = 0;
+#endif
+
+  // Whether the menu leaves 'reserve' bytes of RAM for the stack, Serial and the
+  // application (always true where RAM is unknown)
+  static constexpr bool fitsRam(size_t reserve) {
+    return RAM == 0 || TOTAL + reserve <= RAM;
+  }
+
+  // Plain items fitting in the arena (each MenuDisplay also places its root item there)
+  static constexpr size_t ITEM_CAPACITY = ARENA / ITEM;
+
+  // Arena bytes taken by a menu with these numbers of items, including the root item of
+  // the MenuDisplay. An upper bound: each object is rounded up to the largest alignment.
+  // Layouts created with makeMenuObject() come on top.
+  static constexpr size_t arenaFor(size_t items, size_t liveItems = 0, size_t lazyItems = 0, size_t taskItems = 0) {
+    return (items + 1) * slot(ITEM) + liveItems * slot(LIVE_ITEM) +
+           lazyItems * slot(LAZY_ITEM) + taskItems * slot(TASK_ITEM);
+  }
+
+  // Whether such a menu fits in the arena (always true in the dynamic profile), e.g.
+  //   static_assert(MenuFootprint::fits(12, 2), "raise MENU_ARENA_SIZE");
+  static constexpr bool fits(size_t items, size_t liveItems = 0, size_t lazyItems = 0, size_t taskItems = 0) {
+    return !MENU_STATIC_PROFILE || arenaFor(items, liveItems, lazyItems, taskItems) <= ARENA;
+  }
+
+private:
+  static constexpr size_t ALIGN = alignof(LiveMenuItem) > alignof(TaskMenuItem) ? alignof(LiveMenuItem) : alignof(TaskMenuItem);
+
+  static constexpr size_t slot(size_t size) {
+    return (size + ALIGN - 1) / ALIGN * ALIGN;
+  }
+};
+
+// Footprint without a driver: DRIVER is only the interface here, use
+// MenuFootprintT<YourDisplay> to count the driver's frame buffer.
+using MenuFootprint = MenuFootprintT<DisplayInterface>;
+
+#endif // MENU_FOOTPRINT_H
@@ -0,0 +1,39 @@
+#ifndef MENU_GEOMETRY_H
+#define MENU_GEOMETRY_H
+
+// Axis-aligned rectangle in display pixels
+struct MenuRect {
+  int x = 0;  // Left edge
+  int y = 0;  // Top edge
+  int w = 0;  // Width
+  int h = 0;  // Height
+
+  MenuRect() = default;
+  MenuRect(int x, int y, int w, int h) : x(x), y(y), w(w), h(h) {}
+
+  // Whether the rectangle covers no pixel
+  bool isEmpty() const {
+    return w <= 0 || h <= 0;
+  }
+
+  // Whether (px, py) lies inside the rectangle
+  bool contains(int px, int py) const {
+    return px >= x && px < x + w && py >= y && py < y + h;
+  }
+
+  // Overlapping part of both rectangles (empty if they do not overlap)
+  MenuRect intersect(const MenuRect& other) const {
+    int left = x > other.x ? x : other.x;
+    int top = y > other.y ? y : other.y;
+    int right = (x + w) < (other.x + other.w) ? (x + w) : (other.x + other.w);
+    int bottom = (y + h) < (other.y + other.h) ? (y + h) : (other.y + other.h);
+    return MenuRect(left, top, right - left, bottom - top);
+  }
+
+  // Whether both rectangles share at least one pixel
+  bool intersects(const MenuRect& other) const {
+    return !intersect(other).isEmpty();
+  }
+};
+
+#endif // MENU_GEOMETRY_H
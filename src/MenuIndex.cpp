@@ -0,0 +1,86 @@
+#include "MenuIndex.h"
+#include "MenuItem.h"
+
+// Items below 'node' that build() would visit
+static size_t countItems(const MenuItem& node, int depth) {
+  size_t total = 0;
+  for (const MenuItemPtr& item : node.getSubmenu()) {
+    if (!item) continue;
+    ++total;
+    if (depth < MAX_NAVIGATION_DEPTH) total += countItems(*item, depth + 1);
+  }
+  return total;
+}
+
+void MenuIndex::build(const MenuItem& root, uint32_t version) {
+  // At most 3/4 of the slots in use keeps the probe sequences short
+  size_t size = 8;
+  const size_t wanted = countItems(root, 0) * 2;
+  while (size < wanted && size < slots.max_size()) size *= 2;
+
+  slots.clear();
+  slots.resize(size);
+  for (Entry& entry : slots) entry.index = -1;
+  count = 0;
+  builtVersion = version;
+  built = true;
+  add(root, MENU_PATH_ROOT, -1, 0);
+}
+
+// Indexes the children of 'node', whose id is 'prefix' and which sits in slot 'parent'
+void MenuIndex::add(const MenuItem& node, MenuPathId prefix, int parent, int depth) {
+  const MenuItemList& items = node.getSubmenu();
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (!items[i]) continue;
+    const MenuPathId id = append(prefix, items[i]->getLabelText(), parent < 0);
+    const int slot = insert(id, parent, i);
+    // A duplicate path cannot be told apart from the first one, nor can its children
+    if (slot >= 0 && depth < MAX_NAVIGATION_DEPTH) add(*items[i], id, slot, depth + 1);
+  }
+}
+
+int MenuIndex::insert(MenuPathId id, int parent, int index) {
+  if ((count + 1) * 4 > slots.size() * 3) return -1;  // Full
+  const size_t mask = slots.size() - 1;
+  for (size_t slot = id & mask;; slot = (slot + 1) & mask) {
+    if (slots[slot].index < 0) {
+      slots[slot].id = id;
+      slots[slot].parent = parent;
+      slots[slot].index = index;
+      ++count;
+      return slot;
+    }
+    if (slots[slot].id == id) return -1;
+  }
+}
+
+int MenuIndex::findSlot(MenuPathId id) const {
+  if (slots.empty()) return -1;
+  const size_t mask = slots.size() - 1;
+  for (size_t slot = id & mask; slots[slot].index >= 0; slot = (slot + 1) & mask) {
+    if (slots[slot].id == id) return slot;
+  }
+  return -1;  // Reached an empty slot (there always is one)
+}
+
+int MenuIndex::find(MenuPathId id, int* route) const {
+  int slot = findSlot(id);
+  if (slot < 0) return 0;
+
+  // Collect the positions from the item up to the root menu, then reverse them
+  int levels = 0;
+  for (; slot >= 0 && levels <= MAX_NAVIGATION_DEPTH; slot = slots[slot].parent) {
+    route[levels++] = slots[slot].index;
+  }
+  for (int i = 0; i < levels / 2; ++i) {
+    const int swapped = route[i];
+    route[i] = route[levels - 1 - i];
+    route[levels - 1 - i] = swapped;
+  }
+  return levels;
+}
+
+MenuPathId MenuIndex::hash(const char* text, MenuPathId hash) {
+  for (; *text; ++text) hash = (hash ^ (uint8_t)*text) * 16777619UL;
+  return hash;
+}
@@ -0,0 +1,71 @@
+#ifndef MENU_INDEX_H
+#define MENU_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MenuConfig.h"
+#include "NavigationState.h"  // MAX_NAVIGATION_DEPTH
+
+class MenuItem;
+
+// Identifier of a menu item: the 32-bit FNV-1a hash of its path, the labels from the
+// root menu joined with '/' (e.g. "Settings/WiFi/Scanner"). Computed at compile time
+// by menuPathId(), so deep links can be sent as numbers instead of strings.
+typedef uint32_t MenuPathId;
+
+// Id of the empty path: the root menu
+const MenuPathId MENU_PATH_ROOT = 2166136261UL;
+
+// Returns the id of 'path', continuing the hash 'hash' (usable in constant expressions)
+constexpr MenuPathId menuPathId(const char* path, MenuPathId hash = MENU_PATH_ROOT) {
+  return *path ? menuPathId(path + 1, (hash ^ (uint8_t)*path) * 16777619UL) : hash;
+}
+
+// Hash index from path ids to positions in the menu tree, built once by walking the
+// tree and used by MenuDisplayBase::navigateTo(). Entries only store positions (the
+// index of each item in its parent), never pointers, so a stale index cannot point
+// at a freed item: the caller checks the route it returns against the live tree and
+// rebuilds the index when it no longer matches.
+class MenuIndex {
+public:
+  // Indexes every item of the submenu of 'root' and of their built submenus, down to
+  // MAX_NAVIGATION_DEPTH levels. 'version' identifies the state of the tree.
+  void build(const MenuItem& root, uint32_t version);
+
+  // Writes the position of the item with id 'id' into 'route': the index of the item
+  // entered at each level, then the index of the item itself. Returns the number of
+  // levels written (at least 1), or 0 if 'id' is not in the index.
+  int find(MenuPathId id, int* route) const;
+
+  // Whether the index was built for the tree in state 'version'
+  bool isCurrent(uint32_t version) const { return built && builtVersion == version; }
+  size_t size() const { return count; }  // Indexed items
+
+  // Hashes 'text' into the id 'hash' (the same as menuPathId(), without recursion)
+  static MenuPathId hash(const char* text, MenuPathId hash = MENU_PATH_ROOT);
+
+  // Id of the item labelled 'label' in the submenu of the item with id 'parent'
+  // ('topLevel' = an item of the root menu, whose path has no '/')
+  static MenuPathId append(MenuPathId parent, const char* label, bool topLevel) {
+    return hash(label, topLevel ? parent : hash("/", parent));
+  }
+
+private:
+  // One indexed item; an empty slot has index -1
+  struct Entry {
+    MenuPathId id;
+    int16_t parent;  // Slot of the parent item, -1 for items of the root menu
+    int16_t index;   // Position in the parent's submenu
+  };
+
+  MenuVector<Entry, MENU_INDEX_SLOTS> slots;  // Open addressing with linear probing
+  size_t count = 0;
+  uint32_t builtVersion = 0;
+  bool built = false;
+
+  void add(const MenuItem& node, MenuPathId prefix, int parent, int depth);
+  int insert(MenuPathId id, int parent, int index);  // Returns the slot, -1 if full or a duplicate
+  int findSlot(MenuPathId id) const;                 // Returns the slot, -1 if absent
+};
+
+#endif // MENU_INDEX_H
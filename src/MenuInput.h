@@ -0,0 +1,16 @@
+#ifndef MENU_INPUT_H
+#define MENU_INPUT_H
+
+#include <stdint.h>
+
+// Navigation inputs, as received by MenuDisplay's navigation methods
+enum class MenuInput : uint8_t {
+  UP,      // scrollUp()
+  DOWN,    // scrollDown()
+  LEFT,    // scrollLeft()
+  RIGHT,   // scrollRight()
+  SELECT,  // select()
+  BACK     // goBack()
+};
+
+#endif // MENU_INPUT_H
@@ -1,49 +1,190 @@
 #ifndef MENU_ITEM_H
 #define MENU_ITEM_H
 
-#include <string>
-#include <vector>
-#include <memory>
+#include "MenuConfig.h"
+#include "MenuText.h"
+#include "StringTable.h"
 
 // Simple function pointer type for menu actions (without using std::function)
 using MenuAction = void(*)();
 
+class MenuItem;
+
+// Reference to a menu item, and the children of a menu (see MenuConfig.h for both profiles)
+using MenuItemPtr = MenuPtr<MenuItem>;
+using MenuItemList = MenuVector<MenuItemPtr, MENU_MAX_CHILDREN>;
+
 // Represents a single menu item which may contain an action and/or a submenu
 class MenuItem {
 private:
-    std::string label;  // The label text displayed for this menu item
+    MenuString label;  // The label text displayed for this menu item (UTF-8)
+    StringId stringId = NO_STRING_ID;  // Label in the active StringTable, instead of 'label'
+    mutable MenuText labelGlyphs;  // The label decoded into glyph indices
+    mutable uint16_t glyphGeneration = 0;  // MenuStrings generation 'labelGlyphs' was decoded for
     MenuAction action = nullptr;  // Optional action to execute when item is selected
-    std::vector<std::shared_ptr<MenuItem>> submenu;  // Optional submenu items
+    const uint8_t* icon = nullptr;  // Optional icon for grid layouts (see IconGridLayout)
+    MenuItemList submenu;  // Optional submenu items
 
 public:
     // Constructor with label and optional action
-    MenuItem(const std::string& label, MenuAction action = nullptr)
-        : label(label), action(action) {}
+    MenuItem(MenuLabel label, MenuAction action = nullptr)
+        : label(label), labelGlyphs(menuCString(label)), action(action) {}
+
+    // Constructor with a translated label: the text of 'id' in the active language
+    MenuItem(StringId id, MenuAction action = nullptr)
+        : stringId(id), action(action) {}
 
     virtual ~MenuItem() = default;
 
-    // Returns the label of this menu item
-    const std::string& getLabel() const {
+    // Returns the label of this menu item (empty for items with a StringId)
+    const MenuString& getLabel() const {
         return label;
     }
 
-    // Sets the submenu items for this menu item
-    void setSubmenu(const std::vector<std::shared_ptr<MenuItem>>& items) {
-        submenu = items;
+    // Returns the StringId of the label, or NO_STRING_ID
+    StringId getStringId() const {
+        return stringId;
+    }
+
+    // Returns the label in the active language
+    const char* getLabelText() const {
+        return (stringId == NO_STRING_ID) ? menuCString(label) : MenuStrings::get(stringId);
+    }
+
+    // Returns the text drawn for this item (live items return their formatted value)
+    virtual const char* getText() const {
+        return getLabelText();
+    }
+
+    // Returns getText() decoded into glyph indices, used for drawing and scrolling.
+    // Translated labels are decoded again after the language changed.
+    virtual const MenuText& getGlyphs() const {
+        if (stringId != NO_STRING_ID && glyphGeneration != MenuStrings::getGeneration()) {
+            labelGlyphs.assign(getLabelText());
+            glyphGeneration = MenuStrings::getGeneration();
+        }
+        return labelGlyphs;
+    }
+
+    // For label/value layouts (see TwoColumnLayout): the value is drawn from the glyph
+    // index returned here to the end of getGlyphs(), the label from the first
+    // 'labelLength' glyphs. Returns -1 if the item has no separate value.
+    virtual int getValueStart(int& labelLength) const {
+        return -1;
     }
 
-    // Adds a single submenu item to this menu item
-    void addSubmenuItem(const std::shared_ptr<MenuItem>& item) {
-        submenu.push_back(item);
+    // Sets the icon shown by grid layouts: a bitmap in the format of
+    // DisplayInterface::drawBitmap(), sized as configured in the layout
+    void setIcon(const uint8_t* bitmap) {
+        icon = bitmap;
+    }
+
+    // Returns the icon, or nullptr
+    const uint8_t* getIcon() const {
+        return icon;
+    }
+
+    // Polls the item's value source at time 'now' (ms).
+    // Returns true when the text returned by getText() has changed.
+    virtual bool refresh(unsigned long now) {
+        return false;
+    }
+
+    // Sets the submenu items for this menu item. Empty pointers (items that could not
+    // be created, see makeMenuObject()) are left out.
+    void setSubmenu(const MenuItemList& items) {
+        submenu.clear();
+        submenu.reserve(items.size());
+        for (const MenuItemPtr& item : items) addSubmenuItem(item);
+    }
+
+    // Adds a single submenu item to this menu item (ignored if empty)
+    void addSubmenuItem(const MenuItemPtr& item) {
+        if (item) submenu.push_back(item);
+    }
+
+    // Inserts 'item' at 'index' (0..size) of the submenu; returns false if out of range,
+    // if 'item' is empty or if the submenu is full (MENU_MAX_CHILDREN, static profile)
+    bool insertSubmenuItem(int index, const MenuItemPtr& item) {
+        if (!item || index < 0 || index > (int)submenu.size()) return false;
+        if (submenu.size() >= submenu.max_size()) return false;
+        submenu.insert(submenu.begin() + index, item);
+        return true;
+    }
+
+    // Removes the submenu item at 'index'; returns false if out of range
+    bool removeSubmenuItem(int index) {
+        if (index < 0 || index >= (int)submenu.size()) return false;
+        submenu.erase(submenu.begin() + index);
+        return true;
+    }
+
+    // Replaces the submenu item at 'index' with 'item'; returns false if out of range
+    // or if 'item' is empty
+    bool replaceSubmenuItem(int index, const MenuItemPtr& item) {
+        if (!item || index < 0 || index >= (int)submenu.size()) return false;
+        submenu[index] = item;
+        return true;
+    }
+
+    // Moves the submenu item at 'from' so that it ends up at 'to'; returns false if out of range
+    bool moveSubmenuItem(int from, int to) {
+        if (from < 0 || from >= (int)submenu.size() || to < 0 || to >= (int)submenu.size()) return false;
+        MenuItemPtr item = submenu[from];
+        submenu.erase(submenu.begin() + from);
+        submenu.insert(submenu.begin() + to, item);
+        return true;
+    }
+
+    // Removes all submenu items and frees the memory used by the list
+    void clearSubmenu() {
+        MenuItemList().swap(submenu);
     }
 
     // Checks whether this menu item has a submenu
-    bool hasSubmenu() const {
+    virtual bool hasSubmenu() const {
         return !submenu.empty();
     }
 
+    // Whether the submenu is built on demand and may be released (see LazyMenuItem)
+    virtual bool isLazy() const {
+        return false;
+    }
+
+    // Builds the submenu if it is built on demand; called before the submenu is entered
+    virtual void buildSubmenu() {}
+
+    // Frees a submenu that can be built again later; returns true if it was released
+    virtual bool releaseSubmenu() {
+        return false;
+    }
+
+    // Whether selecting the item starts a background task instead of an action
+    virtual bool hasTask() const {
+        return false;
+    }
+
+    // Starts the item's background task at time 'now' (ms), see TaskMenuItem.
+    // Returns false for items with a plain action.
+    virtual bool startTask(unsigned long now) {
+        return false;
+    }
+
+    // Runs one step of the started task; returns true while it has more work
+    virtual bool stepTask() {
+        return false;
+    }
+
+    // Stops the started task
+    virtual void cancelTask() {}
+
+    // Whether the task is started and not finished yet
+    virtual bool isTaskRunning() const {
+        return false;
+    }
+
     // Returns the submenu associated with this item
-    const std::vector<std::shared_ptr<MenuItem>>& getSubmenu() const {
+    const MenuItemList& getSubmenu() const {
         return submenu;
     }
 
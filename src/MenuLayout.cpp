@@ -0,0 +1,131 @@
+#include "MenuLayout.h"
+
+constexpr int ListLayout::prefixWidth;
+constexpr int ListLayout::maxRowChars;
+
+// One row of the area per requested row
+void ListLayout::computeCells(const MenuRect& area, int rows) {
+  cells.clear();
+  columns = 1;
+  for (int row = 0; row < rows; ++row) {
+    cells.push_back(MenuRect(area.x + 2, area.y + row * lineHeight, area.w - 4, lineHeight));
+  }
+}
+
+// "> " and the label, cut with an ellipsis or scrolled when it does not fit
+void ListLayout::drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) {
+  const MenuText& text = item.getGlyphs();
+  const int availableWidth = cell.w - state.reservedRight - (state.selected ? prefixWidth : 0);
+
+  // Draw selection indicator
+  int textStartX = cell.x;
+  if (state.selected) {
+    display.setCursor(textStartX, cell.y);
+    display.print("> ");
+    textStartX += prefixWidth;
+  }
+
+  // Unselected or short labels are drawn as they are (text wrap is off, so they get clipped)
+  if (!state.selected || text.width() <= availableWidth) {
+    if (text.isAscii()) {
+      display.setCursor(textStartX, cell.y);
+      display.print(item.getText());
+    } else {
+      drawGlyphs(display, textStartX, cell.y, text, 0, text.length());
+    }
+    return;
+  }
+
+  const int charWidth = MENU_GLYPH_WIDTH;
+  if (state.textOffset < 0) {
+    // Whole glyphs up to the ellipsis, never part of a UTF-8 sequence
+    int maxChars = min(availableWidth / charWidth, maxRowChars);
+    int x = textStartX;
+    if (maxChars > 3) {
+      x = drawGlyphs(display, x, cell.y, text, 0, maxChars - 3);
+    }
+    display.setCursor(x, cell.y);
+    display.print("...");
+  } else {
+    // Scroll manual: glyphs are drawn whole from textStartX, so the first one is rounded
+    // up at the end of the scroll to keep the last glyph fully visible inside the cell
+    int maxScroll = max(0, text.width() - availableWidth);
+    int pixelOffset = min(state.textOffset, maxScroll);
+
+    int startChar = (pixelOffset + charWidth - 1) / charWidth;
+    int drawnWidth = 0;
+    int count = 0;
+
+    while (startChar + count < (int)text.length() && count < maxRowChars &&
+           drawnWidth + charWidth <= availableWidth) {
+      ++count;
+      drawnWidth += charWidth;
+    }
+    drawGlyphs(display, textStartX, cell.y, text, startChar, count);
+  }
+}
+
+// Label, then the value right-aligned
+void TwoColumnLayout::drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) {
+  int labelLength = 0;
+  const int valueStart = item.getValueStart(labelLength);
+  if (valueStart < 0) {
+    ListLayout::drawCell(display, item, cell, state);
+    return;
+  }
+
+  const MenuText& text = item.getGlyphs();
+  const int valueLength = text.length() - valueStart;
+  const int valueX = cell.x + cell.w - state.reservedRight - text.widthOf(valueStart, valueLength);
+
+  int x = cell.x;
+  if (state.selected) {
+    display.setCursor(x, cell.y);
+    display.print("> ");
+    x += prefixWidth;
+  }
+
+  // The label gets what the value leaves, with one character of space between them
+  const int labelWidth = valueX - MENU_GLYPH_WIDTH - x;
+  if (labelWidth > 0) {
+    drawGlyphs(display, x, cell.y, text, 0, min(labelLength, text.fit(0, labelWidth)));
+  }
+  drawGlyphs(display, valueX, cell.y, text, valueStart, valueLength);
+}
+
+// Rows of icon cells, on a page boundary when they fit
+void IconGridLayout::computeCells(const MenuRect& area, int rows) {
+  cells.clear();
+  columns = gridColumns;
+
+  // Prefer a top edge on a page boundary (multiple of 8) if the rows still fit below it
+  const int bottom = area.y + area.h;
+  const int cellHeight = iconHeight + 8;  // Icon plus one text line
+  int top = (area.y + 7) & ~7;
+  if (top + gridRows * cellHeight > bottom) top = area.y;
+
+  const int cellWidth = (area.w - 4) / gridColumns;  // Scrollbar strip on the right
+  for (int row = 0; row < gridRows; ++row) {
+    for (int col = 0; col < gridColumns; ++col) {
+      cells.push_back(MenuRect(area.x + col * cellWidth, top + row * cellHeight, cellWidth, cellHeight));
+    }
+  }
+}
+
+// Centered icon with its label below
+void IconGridLayout::drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) {
+  if (item.getIcon()) {
+    display.drawBitmap(cell.x + (cell.w - iconWidth) / 2, cell.y, item.getIcon(), iconWidth, iconHeight, 1);
+  }
+
+  // Centered label, cut to the cell width
+  const MenuText& text = item.getGlyphs();
+  const int count = text.fit(0, cell.w);
+  const int labelY = cell.y + iconHeight;
+  if (state.selected) {
+    display.fillRect(cell.x, labelY, cell.w, 8, 1);
+  }
+  drawGlyphs(display, cell.x + (cell.w - text.widthOf(0, count)) / 2, labelY, text, 0, count,
+             state.selected ? 0 : 1);
+  display.setTextColor(1);
+}
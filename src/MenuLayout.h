@@ -0,0 +1,103 @@
+#ifndef MENU_LAYOUT_H
+#define MENU_LAYOUT_H
+
+#include <DisplayInterface.h>
+#include "MenuGeometry.h"
+#include "MenuItem.h"
+#include "MenuText.h"
+#include <Arduino.h>
+
+// How a cell is drawn, besides its item and rectangle
+struct MenuCellState {
+  bool selected = false;   // The item is selected
+  int textOffset = -1;     // Horizontal scroll of the selected label (pixels), -1 = not scrolled
+  int reservedRight = 0;   // Pixels at the right of the cell taken by the scrollbar
+};
+
+// A menu layout: the screen rectangle of every visible cell, and how a cell is drawn.
+// Cell i shows item scrollOffset + i; the window always starts at a multiple of
+// getColumns(). The table is computed once per layout or display size change, so
+// rendering and navigation only look rectangles up.
+class MenuLayout {
+protected:
+  MenuVector<MenuRect, MENU_MAX_CELLS> cells;  // Visible cells, row by row
+  int columns = 1;              // Cells per row (items per UP/DOWN step)
+
+public:
+  virtual ~MenuLayout() = default;
+
+  // Fills the cell table for the menu area 'area' (below the status bar).
+  // 'rows' is the number of rows requested with setVisibleElements().
+  virtual void computeCells(const MenuRect& area, int rows) = 0;
+
+  // Number of visible cells
+  int getCellCount() const { return cells.size(); }
+
+  // Cells per row
+  int getColumns() const { return columns; }
+
+  // Rectangle of visible cell 'cell'
+  const MenuRect& getCell(int cell) const { return cells[cell]; }
+
+  // Rectangle of item 'index' with the window at 'scrollOffset' (empty if not visible)
+  MenuRect itemRect(int index, int scrollOffset) const {
+    const int cell = index - scrollOffset;
+    return (cell >= 0 && cell < (int)cells.size()) ? cells[cell] : MenuRect();
+  }
+
+  // Items shown with the window at 'scrollOffset' out of 'itemCount': first..last (last < first if none)
+  void visibleRange(int scrollOffset, int itemCount, int& first, int& last) const {
+    first = scrollOffset;
+    last = min(scrollOffset + (int)cells.size(), itemCount) - 1;
+  }
+
+  // Draws 'item' into 'cell'; the cell background is already cleared
+  virtual void drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) = 0;
+};
+
+// The classic menu: one item per row, "> " before the selected item, whose label
+// gets an ellipsis or scrolls horizontally when it is too long
+class ListLayout : public MenuLayout {
+protected:
+  int lineHeight;  // Row height (pixels)
+
+  static constexpr int prefixWidth = 12;  // Width of "> "
+  static constexpr int maxRowChars = 64;  // Upper bound of characters fitting on one row
+
+public:
+  explicit ListLayout(int lineHeight = 10) : lineHeight(lineHeight) {}
+
+  void computeCells(const MenuRect& area, int rows) override;
+  void drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) override;
+};
+
+// Rows with the label on the left and the value right-aligned, e.g. live items
+// ("Temp: 23.4" is shown as "Temp" ... "23.4"). Items without a value are drawn as in the list.
+class TwoColumnLayout : public ListLayout {
+public:
+  explicit TwoColumnLayout(int lineHeight = 10) : ListLayout(lineHeight) {}
+
+  void drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) override;
+};
+
+// Grid of icons with a short label under each, e.g. for a main menu.
+// Icons are bitmaps in the DisplayInterface::drawBitmap() format (MenuItem::setIcon).
+// The grid starts on a display page boundary when it fits, so that the icons are
+// copied whole bytes at a time by page-buffer drivers. UP/DOWN move by one row,
+// LEFT/RIGHT by one item; the selected label is shown inverted.
+class IconGridLayout : public MenuLayout {
+protected:
+  int gridColumns;  // Cells per row
+  int gridRows;     // Visible rows
+  int iconWidth;    // Icon size (pixels)
+  int iconHeight;
+
+public:
+  IconGridLayout(int columns = 4, int rows = 2, int iconWidth = 16, int iconHeight = 16)
+    : gridColumns(columns), gridRows(rows), iconWidth(iconWidth), iconHeight(iconHeight) {}
+
+  void computeCells(const MenuRect& area, int rows) override;
+  void drawCell(DisplayInterface& display, const MenuItem& item, const MenuRect& cell, const MenuCellState& state) override;
+};
+
+#endif // MENU_LAYOUT_H
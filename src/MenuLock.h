@@ -0,0 +1,33 @@
+#ifndef MENU_LOCK_H
+#define MENU_LOCK_H
+
+// Lock protecting the menu tree and navigation state, so that menus can be
+// changed from a producer task (e.g. a BLE or WiFi scan) while the UI task renders.
+// Every public MenuDisplay method holds it, accessors included.
+#if defined(ARDUINO_ARCH_AVR)
+// Single-threaded targets: locking compiles to nothing
+class MenuLock {
+public:
+  void lock() {}
+  void unlock() {}
+};
+#else
+#include <mutex>
+// Recursive, because public MenuDisplay methods call each other (e.g. update() -> render())
+using MenuLock = std::recursive_mutex;
+#endif
+
+// Holds a MenuLock for the lifetime of the guard
+class MenuLockGuard {
+private:
+  MenuLock& menuLock;
+
+public:
+  explicit MenuLockGuard(MenuLock& lock) : menuLock(lock) { menuLock.lock(); }
+  ~MenuLockGuard() { menuLock.unlock(); }
+
+  MenuLockGuard(const MenuLockGuard&) = delete;
+  MenuLockGuard& operator=(const MenuLockGuard&) = delete;
+};
+
+#endif // MENU_LOCK_H
@@ -0,0 +1,34 @@
+#ifndef MENU_PROGMEM_H
+#define MENU_PROGMEM_H
+
+// Constant tables (fonts, sprites, string tables) are marked PROGMEM and read with
+// pgm_read_byte(), pgm_read_ptr(), memcpy_P() or strncpy_P(). On AVR, flash and RAM are separate address spaces and plain 'const'
+// data is copied to RAM at startup; PROGMEM keeps it in flash. Elsewhere constant data
+// is already read from flash, and these compile to plain reads.
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/pgmspace.h>
+#else
+#if defined(ARDUINO)
+#include <Arduino.h>  // Other cores provide pgmspace.h through it
+#endif
+#include <stdint.h>
+#include <string.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#endif
+#ifndef pgm_read_ptr
+#define pgm_read_ptr(address) (*(const void* const*)(address))
+#endif
+#ifndef memcpy_P
+#define memcpy_P memcpy
+#endif
+#ifndef strncpy_P
+#define strncpy_P strncpy
+#endif
+#endif
+
+#endif // MENU_PROGMEM_H
@@ -0,0 +1,134 @@
+#include "MenuText.h"
+#include "MenuProgmem.h"
+#include <DisplayInterface.h>
+
+// Extended glyphs, 5 columns each, bit 0 = top row, bit 7 = below the baseline.
+// Lowercase accents sit in the two rows above the x-height, capitals with an accent
+// are drawn one or two rows shorter to leave room for it.
+const uint8_t MenuText::EXTENDED_GLYPHS[EXTENDED_COUNT][5] PROGMEM = {
+  { 0x20, 0x55, 0x56, 0x79, 0x40 },  // ă
+  { 0x20, 0x56, 0x55, 0x7A, 0x40 },  // â
+  { 0x00, 0x46, 0x7D, 0x42, 0x00 },  // î
+  { 0x48, 0x54, 0xD4, 0x54, 0x24 },  // ș
+  { 0x04, 0x04, 0xBF, 0x44, 0x24 },  // ț
+  { 0x78, 0x15, 0x16, 0x15, 0x78 },  // Ă
+  { 0x78, 0x16, 0x15, 0x16, 0x78 },  // Â
+  { 0x00, 0x46, 0x7D, 0x46, 0x00 },  // Î
+  { 0x46, 0x49, 0xC9, 0x49, 0x31 },  // Ș
+  { 0x01, 0x81, 0x7F, 0x01, 0x01 },  // Ț
+  { 0x20, 0x55, 0x54, 0x79, 0x40 },  // ä
+  { 0x38, 0x45, 0x44, 0x45, 0x38 },  // ö
+  { 0x3C, 0x41, 0x40, 0x21, 0x7C },  // ü
+  { 0x7D, 0x12, 0x11, 0x12, 0x7D },  // Ä
+  { 0x3D, 0x42, 0x42, 0x42, 0x3D },  // Ö
+  { 0x3D, 0x40, 0x40, 0x40, 0x3D },  // Ü
+  { 0xFE, 0x01, 0x49, 0x56, 0x20 },  // ß
+};
+
+// Code points of the extended glyphs. The cedilla forms ş ţ Ş Ţ, still common in
+// Romanian text, share the glyphs of the comma-below letters.
+static const struct {
+  uint16_t codePoint;
+  uint8_t glyph;
+} EXTENDED_MAP[] = {
+  { 0x0103, 0x80 }, { 0x00E2, 0x81 }, { 0x00EE, 0x82 }, { 0x0219, 0x83 }, { 0x021B, 0x84 },
+  { 0x0102, 0x85 }, { 0x00C2, 0x86 }, { 0x00CE, 0x87 }, { 0x0218, 0x88 }, { 0x021A, 0x89 },
+  { 0x00E4, 0x8A }, { 0x00F6, 0x8B }, { 0x00FC, 0x8C },
+  { 0x00C4, 0x8D }, { 0x00D6, 0x8E }, { 0x00DC, 0x8F }, { 0x00DF, 0x90 },
+  { 0x015F, 0x83 }, { 0x0163, 0x84 }, { 0x015E, 0x88 }, { 0x0162, 0x89 },
+};
+
+uint8_t MenuText::glyphFor(uint32_t codePoint) {
+  if (codePoint < 0x80) return (uint8_t)codePoint;
+  for (const auto& entry : EXTENDED_MAP) {
+    if (entry.codePoint == codePoint) return entry.glyph;
+  }
+  return '?';
+}
+
+void MenuText::assign(const char* utf8) {
+  glyphs.clear();
+  pixelWidth = 0;
+  ascii = true;
+
+  const uint8_t* p = (const uint8_t*)utf8;
+  while (*p) {
+    const uint8_t lead = *p++;
+    uint32_t codePoint;
+    int continuation;
+    if (lead < 0x80) {
+      codePoint = lead;
+      continuation = 0;
+    } else if ((lead & 0xE0) == 0xC0) {
+      codePoint = lead & 0x1F;
+      continuation = 1;
+    } else if ((lead & 0xF0) == 0xE0) {
+      codePoint = lead & 0x0F;
+      continuation = 2;
+    } else if ((lead & 0xF8) == 0xF0) {
+      codePoint = lead & 0x07;
+      continuation = 3;
+    } else {
+      codePoint = 0xFFFD;  // Stray continuation byte
+      continuation = 0;
+    }
+    while (continuation > 0 && (*p & 0xC0) == 0x80) {
+      codePoint = (codePoint << 6) | (*p++ & 0x3F);
+      --continuation;
+    }
+    if (continuation > 0) codePoint = 0xFFFD;  // Truncated sequence
+
+    if (glyphs.size() >= glyphs.max_size()) break;  // Longer labels are cut (MENU_MAX_LABEL_LENGTH)
+    if (lead >= 0x80) ascii = false;
+    const uint8_t glyph = glyphFor(codePoint);
+    glyphs.push_back(glyph);
+    pixelWidth += glyphWidth(glyph);
+  }
+}
+
+// Draws extended glyph 'glyph' with its top left corner at (x, y)
+void drawExtendedGlyph(DisplayInterface& display, int x, int y, uint8_t glyph, int color) {
+  uint8_t columns[5];  // The glyph table is in flash
+  memcpy_P(columns, MenuText::EXTENDED_GLYPHS[glyph - MenuText::EXTENDED_FIRST], sizeof(columns));
+  display.drawBitmap(x, y, columns, 5, 8, color);
+}
+
+// Draws glyphs first..first+count-1 of 'text' at (x, y) in 'color' and returns the x
+// after them. Runs of ASCII glyphs go through the display font in one print() call,
+// extended glyphs are drawn from MenuText::EXTENDED_GLYPHS.
+int drawGlyphs(DisplayInterface& display, int x, int y, const MenuText& text, size_t first, size_t count, int color) {
+  constexpr int maxRun = 64;
+  char run[maxRun + 1];
+  int runLength = 0;
+  int runX = x;
+
+  // Prints the collected ASCII glyphs at the position where the run started
+  auto flushRun = [&]() {
+    if (runLength == 0) return;
+    run[runLength] = '\0';
+    display.setCursor(runX, y);
+    display.print(run);
+    runLength = 0;
+  };
+
+  display.setTextColor(color);
+  const size_t last = (first + count < text.length()) ? first + count : text.length();
+  for (size_t i = first; i < last; ++i) {
+    const uint8_t glyph = text[i];
+    if (MenuText::isExtended(glyph)) {
+      flushRun();
+      drawExtendedGlyph(display, x, y, glyph, color);
+      x += MenuText::glyphWidth(glyph);
+      runX = x;
+    } else {
+      if (runLength == maxRun) {
+        flushRun();
+        runX = x;
+      }
+      run[runLength++] = (char)glyph;
+      x += MenuText::glyphWidth(glyph);
+    }
+  }
+  flushRun();
+  return x;
+}
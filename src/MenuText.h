@@ -0,0 +1,89 @@
+#ifndef MENU_TEXT_H
+#define MENU_TEXT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MenuConfig.h"
+
+class DisplayInterface;
+
+// Width of one glyph of the built-in 5x7 font including the spacing column (pixels)
+#define MENU_GLYPH_WIDTH 6
+
+// A UTF-8 text decoded into glyph indices of the display font.
+// Indices 0x00-0x7F are the ASCII characters drawn by the display's own font,
+// indices from EXTENDED_FIRST are the Romanian and German letters in EXTENDED_GLYPHS.
+// Code points without a glyph are shown as '?'. The text is decoded once when it is
+// assigned, so drawing and scrolling work on glyph counts instead of UTF-8 bytes.
+class MenuText {
+private:
+  MenuVector<uint8_t, MENU_MAX_LABEL_LENGTH> glyphs;  // One glyph index per character
+  int pixelWidth = 0;           // Cached width of the whole text (pixels)
+  bool ascii = true;            // Whether the source was plain ASCII (drawn with print())
+
+  static uint8_t glyphFor(uint32_t codePoint);  // Glyph index of a Unicode code point
+
+public:
+  // Extended glyphs: ă â î ș ț Ă Â Î Ș Ț ä ö ü Ä Ö Ü ß
+  static const uint8_t EXTENDED_FIRST = 0x80;
+  static const uint8_t EXTENDED_COUNT = 17;
+
+  // 5 columns per extended glyph, bit 0 = top row (same layout as the Adafruit GFX font), PROGMEM
+  static const uint8_t EXTENDED_GLYPHS[EXTENDED_COUNT][5];
+
+  MenuText() = default;
+  explicit MenuText(const char* utf8) { assign(utf8); }
+
+  // Decodes 'utf8' into glyph indices and caches its width
+  void assign(const char* utf8);
+
+  // Reserves room for 'count' glyphs, so that later assign() calls do not allocate
+  void reserve(size_t count) { glyphs.reserve(count); }
+
+  // Number of glyphs (characters, not bytes)
+  size_t length() const { return glyphs.size(); }
+
+  // Glyph index of character 'index'
+  uint8_t operator[](size_t index) const { return glyphs[index]; }
+
+  // Width of the whole text (pixels)
+  int width() const { return pixelWidth; }
+
+  // Whether the text contains only ASCII characters
+  bool isAscii() const { return ascii; }
+
+  // Number of glyphs from 'first' on that fit into 'maxWidth' pixels
+  int fit(size_t first, int maxWidth) const {
+    int count = 0;
+    for (size_t i = first; i < glyphs.size(); ++i, ++count) {
+      maxWidth -= glyphWidth(glyphs[i]);
+      if (maxWidth < 0) break;
+    }
+    return count;
+  }
+
+  // Width of 'count' glyphs starting at 'first' (pixels)
+  int widthOf(size_t first, size_t count) const {
+    int width = 0;
+    for (size_t i = first; i < first + count && i < glyphs.size(); ++i) {
+      width += glyphWidth(glyphs[i]);
+    }
+    return width;
+  }
+
+  // Width of a single glyph (pixels)
+  static int glyphWidth(uint8_t glyph) { return MENU_GLYPH_WIDTH; }
+
+  // Whether 'glyph' is drawn from EXTENDED_GLYPHS instead of the display font
+  static bool isExtended(uint8_t glyph) { return glyph >= EXTENDED_FIRST; }
+};
+
+// Draws extended glyph 'glyph' with its top left corner at (x, y)
+void drawExtendedGlyph(DisplayInterface& display, int x, int y, uint8_t glyph, int color);
+
+// Draws glyphs first..first+count-1 of 'text' at (x, y) in 'color' and returns the x
+// after them. Runs of ASCII glyphs go through the display font in one print() call,
+// extended glyphs are drawn from MenuText::EXTENDED_GLYPHS.
+int drawGlyphs(DisplayInterface& display, int x, int y, const MenuText& text, size_t first, size_t count, int color = 1);
+
+#endif // MENU_TEXT_H
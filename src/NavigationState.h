@@ -0,0 +1,73 @@
+#ifndef NAVIGATION_STATE_H
+#define NAVIGATION_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Deepest submenu level that can be saved and restored
+#ifndef MAX_NAVIGATION_DEPTH
+#define MAX_NAVIGATION_DEPTH 8
+#endif
+
+// Position of the user in the menu tree, small enough to be stored in NVS/EEPROM.
+// Indices are stored as bytes, so menus with more than 255 items are clamped.
+struct NavigationState {
+  static const uint8_t VERSION = 1;  // Format version, bumped when the layout changes
+
+  // Largest serialized size: version, depth, (index, scroll) per level, selection, scroll, checksum
+  static const size_t MAX_SIZE = 2 + 2 * MAX_NAVIGATION_DEPTH + 2 + 1;
+
+  uint8_t depth = 0;                          // Number of submenus entered from the root
+  uint8_t path[MAX_NAVIGATION_DEPTH] = {};    // Index of the item entered at each level
+  uint8_t scroll[MAX_NAVIGATION_DEPTH] = {};  // Scroll offset of each parent level
+  uint8_t selectedIndex = 0;                  // Selection in the deepest (current) menu
+  uint8_t scrollOffset = 0;                   // Scroll offset of the deepest (current) menu
+
+  // Writes the state into 'buffer'; returns the number of bytes used (0 if 'size' is too small)
+  size_t serialize(uint8_t* buffer, size_t size) const {
+    const size_t needed = 2 + 2 * depth + 2 + 1;
+    if (size < needed) return 0;
+
+    size_t n = 0;
+    buffer[n++] = VERSION;
+    buffer[n++] = depth;
+    for (uint8_t level = 0; level < depth; ++level) {
+      buffer[n++] = path[level];
+      buffer[n++] = scroll[level];
+    }
+    buffer[n++] = selectedIndex;
+    buffer[n++] = scrollOffset;
+    buffer[n] = checksum(buffer, n);
+    return n + 1;
+  }
+
+  // Reads a state written by serialize(); returns false (leaving it unchanged) if the data is invalid
+  bool deserialize(const uint8_t* buffer, size_t size) {
+    if (size < 5 || buffer[0] != VERSION || buffer[1] > MAX_NAVIGATION_DEPTH) return false;
+    const uint8_t savedDepth = buffer[1];
+    const size_t length = 2 + 2 * savedDepth + 2;
+    if (size < length + 1 || buffer[length] != checksum(buffer, length)) return false;
+
+    size_t n = 2;
+    depth = savedDepth;
+    for (uint8_t level = 0; level < depth; ++level) {
+      path[level] = buffer[n++];
+      scroll[level] = buffer[n++];
+    }
+    selectedIndex = buffer[n++];
+    scrollOffset = buffer[n];
+    return true;
+  }
+
+private:
+  // Simple rotating checksum, enough to reject erased or partially written storage
+  static uint8_t checksum(const uint8_t* data, size_t length) {
+    uint8_t sum = 0x5A;
+    for (size_t i = 0; i < length; ++i) {
+      sum = (uint8_t)((sum << 1) | (sum >> 7)) ^ data[i];
+    }
+    return sum;
+  }
+};
+
+#endif // NAVIGATION_STATE_H
@@ -0,0 +1,113 @@
+#ifndef NAVIGATION_STORE_H
+#define NAVIGATION_STORE_H
+
+#include "NavigationState.h"
+
+// Storage backend for a serialized NavigationState (see MenuDisplayBase::saveNavigation)
+class NavigationStore {
+public:
+  virtual ~NavigationStore() = default;
+
+  // Stores 'size' bytes; returns false on failure
+  virtual bool save(const uint8_t* data, size_t size) = 0;
+
+  // Reads up to 'capacity' bytes into 'data'; returns the number of bytes read (0 if nothing is stored)
+  virtual size_t load(uint8_t* data, size_t capacity) = 0;
+};
+
+#if defined(ESP32)
+#include <Preferences.h>
+#include <string.h>
+
+// Stores the navigation state in the ESP32 NVS partition
+class NvsNavigationStore : public NavigationStore {
+private:
+  const char* nvsNamespace;  // NVS namespace (max 15 characters)
+  const char* key;           // Key inside the namespace
+
+public:
+  NvsNavigationStore(const char* nvsNamespace = "menu", const char* key = "nav")
+    : nvsNamespace(nvsNamespace), key(key) {}
+
+  bool save(const uint8_t* data, size_t size) override {
+    Preferences prefs;
+    if (!prefs.begin(nvsNamespace, false)) return false;
+
+    // Skip the flash write if nothing changed since the last save
+    uint8_t current[NavigationState::MAX_SIZE];
+    size_t currentSize = prefs.getBytes(key, current, sizeof(current));
+    bool ok = (currentSize == size && memcmp(current, data, size) == 0) ||
+              prefs.putBytes(key, data, size) == size;
+    prefs.end();
+    return ok;
+  }
+
+  size_t load(uint8_t* data, size_t capacity) override {
+    Preferences prefs;
+    if (!prefs.begin(nvsNamespace, true)) return 0;
+    size_t size = prefs.isKey(key) ? prefs.getBytes(key, data, capacity) : 0;
+    prefs.end();
+    return size;
+  }
+};
+#endif
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <EEPROM.h>
+
+// Stores the navigation state in the AVR EEPROM, starting at 'address'
+class EepromNavigationStore : public NavigationStore {
+private:
+  int address;  // First EEPROM byte used; MAX_SIZE + 1 bytes are reserved
+
+public:
+  explicit EepromNavigationStore(int address = 0) : address(address) {}
+
+  bool save(const uint8_t* data, size_t size) override {
+    EEPROM.update(address, (uint8_t)size);  // update() only writes bytes that changed
+    for (size_t i = 0; i < size; ++i) {
+      EEPROM.update(address + 1 + i, data[i]);
+    }
+    return true;
+  }
+
+  size_t load(uint8_t* data, size_t capacity) override {
+    size_t size = EEPROM.read(address);
+    if (size > capacity) return 0;  // Erased (0xFF) or foreign data
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = EEPROM.read(address + 1 + i);
+    }
+    return size;
+  }
+};
+#endif
+
+#if !defined(ARDUINO)
+#include <cstdio>
+
+// Stores the navigation state in a file (host builds and simulators)
+class FileNavigationStore : public NavigationStore {
+private:
+  const char* path;  // File path
+
+public:
+  explicit FileNavigationStore(const char* path) : path(path) {}
+
+  bool save(const uint8_t* data, size_t size) override {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(data, 1, size, file) == size;
+    return (fclose(file) == 0) && ok;
+  }
+
+  size_t load(uint8_t* data, size_t capacity) override {
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    size_t size = fread(data, 1, capacity, file);
+    fclose(file);
+    return size;
+  }
+};
+#endif
+
+#endif // NAVIGATION_STORE_H
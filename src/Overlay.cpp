@@ -0,0 +1,103 @@
+#include "Overlay.h"
+
+// ========== Overlay ==========
+
+// Clears the bounds and draws a 1 pixel frame around them
+void Overlay::drawFrame(DisplayInterface& display) const {
+  display.fillRect(bounds.x, bounds.y, bounds.w, bounds.h, 0);
+  display.drawFastHLine(bounds.x, bounds.y, bounds.w, 1);
+  display.drawFastHLine(bounds.x, bounds.y + bounds.h - 1, bounds.w, 1);
+  display.fillRect(bounds.x, bounds.y, 1, bounds.h, 1);
+  display.fillRect(bounds.x + bounds.w - 1, bounds.y, 1, bounds.h, 1);
+}
+
+// Prints 'text' horizontally centered in the bounds at height 'y'
+void Overlay::printCentered(DisplayInterface& display, const char* text, int y) const {
+  const int charWidth = 6;
+  int textWidth = strlen(text) * charWidth;
+  display.setCursor(bounds.x + (bounds.w - textWidth) / 2, y);
+  display.print(text);
+}
+
+// ========== Toast ==========
+
+// Sizes the box to the message and centers it on the screen
+Toast::Toast(const char* message, int screenWidth, int screenHeight, int zOrder)
+  : Overlay(MenuRect(), zOrder) {
+  setText(message);
+  const int width = min((int)strlen(text) * 6 + 8, screenWidth);
+  const int height = 14;
+  bounds = MenuRect((screenWidth - width) / 2, (screenHeight - height) / 2, width, height);
+  fitText();
+}
+
+// Copies the message and redraws the toast
+void Toast::setText(const char* message) {
+  strncpy(text, message, sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+  fitText();
+  invalidate();
+}
+
+// Cuts the message to the characters fitting in the box, once it has one
+void Toast::fitText() {
+  const int fit = max((bounds.w - 8) / 6, 0);
+  if (bounds.w > 0 && fit < (int)strlen(text)) text[fit] = '\0';
+}
+
+void Toast::draw(DisplayInterface& display) {
+  drawFrame(display);
+  display.setTextColor(1);
+  printCentered(display, text, bounds.y + 3);
+}
+
+// ========== ConfirmDialog ==========
+
+// Sizes the box to the question (at least wide enough for the answers) and centers it
+ConfirmDialog::ConfirmDialog(const char* text, DialogCallback callback,
+                             int screenWidth, int screenHeight, int zOrder)
+  : Overlay(MenuRect(), zOrder), callback(callback) {
+  strncpy(question, text, sizeof(question) - 1);
+  question[sizeof(question) - 1] = '\0';
+  const int width = min(max((int)strlen(question) * 6 + 8, 72), screenWidth);
+  const int height = 28;
+  bounds = MenuRect((screenWidth - width) / 2, (screenHeight - height) / 2, width, height);
+}
+
+void ConfirmDialog::draw(DisplayInterface& display) {
+  const MenuRect& b = bounds;
+  drawFrame(display);
+  display.setTextColor(1);
+  printCentered(display, question, b.y + 3);
+
+  // Answers, the selected one drawn inverted
+  const int answerY = b.y + 15;
+  const int answerWidth = 24;
+  const int yesX = b.x + b.w / 2 - answerWidth - 4;
+  const int noX = b.x + b.w / 2 + 4;
+  display.fillRect(yesSelected ? yesX : noX, answerY - 1, answerWidth, 10, 1);
+  display.setTextColor(yesSelected ? 0 : 1);
+  display.setCursor(yesX + 3, answerY);
+  display.print("Yes");
+  display.setTextColor(yesSelected ? 1 : 0);
+  display.setCursor(noX + 6, answerY);
+  display.print("No");
+  display.setTextColor(1);
+}
+
+bool ConfirmDialog::handleInput(MenuInput input) {
+  switch (input) {
+    case MenuInput::SELECT:
+    case MenuInput::BACK: {
+      bool confirmed = (input == MenuInput::SELECT) && yesSelected;
+      close();
+      if (callback) callback(confirmed);
+      break;
+    }
+    default:
+      yesSelected = !yesSelected;
+      invalidate();
+      break;
+  }
+  return true;  // Modal: the menu below gets no input
+}
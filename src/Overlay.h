@@ -0,0 +1,98 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include <DisplayInterface.h>
+#include "MenuConfig.h"     // OVERLAY_TEXT_SIZE
+#include "MenuGeometry.h"
+#include "MenuInput.h"
+#include <string.h>
+#include <Arduino.h>
+
+// A widget drawn on top of the menu (popup, toast, dialog), see MenuDisplay::showOverlay().
+// The compositor saves the pixels under the overlay, so hiding it restores the menu
+// without re-rendering it. Overlays must only draw inside their bounds.
+class Overlay {
+protected:
+  MenuRect bounds;             // Screen area covered by the overlay
+  int zOrder;                  // Higher values are drawn on top
+  bool dirty = false;          // Content changed, redraw this overlay only
+  bool closeRequested = false; // The overlay asked to be removed
+
+public:
+  Overlay(const MenuRect& bounds, int zOrder = 0)
+    : bounds(bounds), zOrder(zOrder) {}
+
+  virtual ~Overlay() = default;
+
+  // Draws the overlay inside getBounds()
+  virtual void draw(DisplayInterface& display) = 0;
+
+  // Receives navigation input while this is the top overlay; return true to consume it
+  // (modal overlays), false to let the menu handle it
+  virtual bool handleInput(MenuInput input) {
+    return false;
+  }
+
+  // Requests a redraw of this overlay only (e.g. after its text changed)
+  void invalidate() { dirty = true; }
+
+  // Asks the compositor to remove the overlay on the next update()
+  void close() { closeRequested = true; }
+
+  const MenuRect& getBounds() const { return bounds; }
+  int getZOrder() const { return zOrder; }
+  bool isDirty() const { return dirty; }
+  void clearDirty() { dirty = false; }
+  bool isCloseRequested() const { return closeRequested; }
+
+  // Called by the compositor when the overlay is shown (again)
+  void resetClose() { closeRequested = false; }
+
+protected:
+  // Clears the bounds and draws a 1 pixel frame around them
+  void drawFrame(DisplayInterface& display) const;
+
+  // Prints 'text' horizontally centered in the bounds at height 'y'
+  void printCentered(DisplayInterface& display, const char* text, int y) const;
+};
+
+// Short message in a framed box, e.g. "Saved". Does not take input.
+class Toast : public Overlay {
+private:
+  char text[OVERLAY_TEXT_SIZE];  // Message shown in the box
+
+public:
+  // Toast sized to 'message', centered on a 'screenWidth' x 'screenHeight' display
+  Toast(const char* message, int screenWidth = 128, int screenHeight = 64, int zOrder = 0);
+
+  // Changes the message; only the toast is redrawn (the box keeps its size, longer
+  // messages are cut)
+  void setText(const char* message);
+
+  void draw(DisplayInterface& display) override;
+
+private:
+  // Cuts the message to the characters fitting in the box, once it has one
+  void fitText();
+};
+
+// Function pointer called when a confirmation dialog is answered
+using DialogCallback = void(*)(bool confirmed);
+
+// Modal yes/no question. Left/right/up/down switch the answer, select confirms it,
+// back answers "no". The dialog closes itself after calling the callback.
+class ConfirmDialog : public Overlay {
+private:
+  char question[OVERLAY_TEXT_SIZE];  // Text shown above the answers
+  DialogCallback callback;           // Receives the answer
+  bool yesSelected = false;          // Currently highlighted answer
+
+public:
+  ConfirmDialog(const char* text, DialogCallback callback,
+                int screenWidth = 128, int screenHeight = 64, int zOrder = 10);
+
+  void draw(DisplayInterface& display) override;
+  bool handleInput(MenuInput input) override;
+};
+
+#endif // OVERLAY_H
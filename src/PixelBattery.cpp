@@ -1,11 +1,12 @@
-#include <string>
+#include <stdio.h>
+#include <string.h>
 #include "PixelBattery.h"
 
 
 // Sprite definitions - 9x14 pixel arrays representing different battery states
 
 // Full battery icon (100% charge)
-const uint8_t PixelBattery::BATTERY_FULL[9][14] = {
+const uint8_t PixelBattery::BATTERY_FULL[9][14] PROGMEM = {
   { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }, 
   { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }, 
   { 1, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1 }, 
@@ -18,7 +19,7 @@ const uint8_t PixelBattery::BATTERY_FULL[9][14] = {
 };
 
 // 65% battery icon (similar structure but with fewer bars)
-const uint8_t PixelBattery::BATTERY_65[9][14] = {
+const uint8_t PixelBattery::BATTERY_65[9][14] PROGMEM = {
   { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
   { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
   { 1, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 1 }, 
@@ -31,7 +32,7 @@ const uint8_t PixelBattery::BATTERY_65[9][14] = {
 };
 
 // 30% battery icon (only one bar visible)
-const uint8_t PixelBattery::BATTERY_30[9][14] = {
+const uint8_t PixelBattery::BATTERY_30[9][14] PROGMEM = {
   { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
   { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
   { 1, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1 }, 
@@ -44,7 +45,7 @@ const uint8_t PixelBattery::BATTERY_30[9][14] = {
 };
 
 // Empty battery icon (no bars visible)
-const uint8_t PixelBattery::BATTERY_EMPTY[9][14] = {
+const uint8_t PixelBattery::BATTERY_EMPTY[9][14] PROGMEM = {
   { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
   { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
   { 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }, 
@@ -57,7 +58,7 @@ const uint8_t PixelBattery::BATTERY_EMPTY[9][14] = {
 };
 
 // Charging battery icon (with lightning Plug symbol)
-const uint8_t PixelBattery::BATTERY_CHARGING[9][14] = {
+const uint8_t PixelBattery::BATTERY_CHARGING[9][14] PROGMEM = {
   { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
   { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
   { 1, 1, 1, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1 }, 
@@ -73,16 +74,15 @@ const uint8_t PixelBattery::BATTERY_CHARGING[9][14] = {
 
 // Draw method implementation
 void PixelBattery::draw(DisplayInterface& display, int xx, int yy) {
-  // Pointer to the selected sprite
-  const uint8_t(*sprite)[14];
-  
   // Calculate drawing position with offsets
   // Adjust X position based on whether icon is left or right aligned
-  int drawX = x + xx + ((position == StatusBarElementPosition::LEFT) ? offsetX : -offsetX); 
+  const bool isLeft = (position == StatusBarElementPosition::LEFT);
+  int drawX = x + xx + (isLeft ? offsetX : -offsetX);
   // Y position with vertical offset
   int drawY = y + yy + offsetY;
 
   // Select appropriate sprite based on battery state
+  const uint8_t(*sprite)[14];
   if (isCharging) {
     sprite = BATTERY_CHARGING;
   } else if (level > 65) {
@@ -104,23 +104,17 @@ void PixelBattery::draw(DisplayInterface& display, int xx, int yy) {
   } else {
     snprintf(textBuf, sizeof(textBuf), " %d%%", level); // Double digit
   }
-  
+
   // Calculate text dimensions
   const int charWidth = 6; // Width of each character
   const int batteryWidth = 14; // Width of battery icon
   const int textWidth = strlen(textBuf) * charWidth; // Total text width
 
   // Handle left-aligned position
-  if (position == StatusBarElementPosition::LEFT) {
+  if (isLeft) {
     // Draw battery icon
-    for (int row = 0; row < 9; row++) {
-      for (int col = 0; col < 14; col++) {
-        if (sprite[row][col]) {
-          display.drawPixel(drawX + col, drawY + row, color);
-        }
-      }
-    }
-    
+    drawSprite(display, sprite, drawX, drawY, color);
+
     // Draw percentage text if enabled
     if (percent) {
       display.setTextColor(color);
@@ -138,13 +132,7 @@ void PixelBattery::draw(DisplayInterface& display, int xx, int yy) {
     
     // Draw battery icon after text for right alignment
     int batteryStartX = drawX + (percent ? textWidth : 0);
-    for (int row = 0; row < 9; row++) {
-      for (int col = 0; col < 14; col++) {
-        if (sprite[row][col]) {
-          display.drawPixel(batteryStartX + col, drawY + row, color);
-        }
-      }
-    }
+    drawSprite(display, sprite, batteryStartX, drawY, color);
   }
 }
 
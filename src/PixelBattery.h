@@ -9,7 +9,7 @@
 // Inherits from StatusBarElement to integrate into a status bar system.
 class PixelBattery : public StatusBarElement {
 private:
-  // Static 2D arrays that define the pixel representation of various battery states
+  // Static 2D arrays that define the pixel representation of various battery states (PROGMEM)
   static const uint8_t BATTERY_FULL[9][14];     // Icon for 100% battery
   static const uint8_t BATTERY_65[9][14];       // Icon for ~65% battery
   static const uint8_t BATTERY_30[9][14];       // Icon for ~30% battery
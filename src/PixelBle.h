@@ -7,10 +7,10 @@
 // The PixelBle class represents a graphical status bar element that displays the Bluetooth (BLE) connection status.
 class PixelBle : public StatusBarElement {
 private:
-  // BLE disconnected icon (9x14 pixel sprite)
+  // BLE disconnected icon (9x14 pixel sprite, PROGMEM)
   static const uint8_t BLE[9][14];
 
-  // BLE connected icon (9x14 pixel sprite)
+  // BLE connected icon (9x14 pixel sprite, PROGMEM)
   static const uint8_t BLE_CONNECTED[9][14];
 
   // Bluetooth connection status: true = connected, false = disconnected
@@ -2,6 +2,8 @@
 #define STATUSBARELEMENT_H
 
 #include <DisplayInterface.h>
+#include <stdint.h>
+#include "MenuProgmem.h"
 
 // Enum to define possible positions of a status bar element
 enum class StatusBarElementPosition {
@@ -19,6 +21,17 @@ protected:
     int color = 1;          // Color used for rendering the element
     StatusBarElementPosition position = StatusBarElementPosition::LEFT; // Default position
 
+    // Draws a 9x14 sprite (one byte per pixel, 0 = transparent, in flash) at (drawX, drawY)
+    static void drawSprite(DisplayInterface& display, const uint8_t (*sprite)[14], int drawX, int drawY, int color) {
+        for (int row = 0; row < 9; row++) {
+            for (int col = 0; col < 14; col++) {
+                if (pgm_read_byte(&sprite[row][col])) {
+                    display.drawPixel(drawX + col, drawY + row, color);
+                }
+            }
+        }
+    }
+
 public:
     StatusBarElement() = default;
 
@@ -0,0 +1,19 @@
+#include "StringTable.h"
+#include "MenuProgmem.h"
+
+const StringTable* MenuStrings::table = nullptr;
+uint16_t MenuStrings::generation = 1;
+
+void MenuStrings::setTable(const StringTable* strings) {
+  table = strings;
+  if (++generation == 0) generation = 1;  // 0 means "never decoded" in MenuItem
+}
+
+const char* MenuStrings::getFromFlash(StringId id) {
+  static char buffer[MENU_MAX_STRING_BYTES + 1];
+  const char* text = (const char*)pgm_read_ptr(&table->strings[id]);
+  if (!text) return "?";
+  strncpy_P(buffer, text, MENU_MAX_STRING_BYTES);
+  buffer[MENU_MAX_STRING_BYTES] = '\0';
+  return buffer;
+}
@@ -0,0 +1,61 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <stdint.h>
+#include "MenuConfig.h"
+
+// Index of a text in every language's StringTable
+using StringId = uint16_t;
+
+// Marks a menu item whose label is its own string, not a table entry
+#define NO_STRING_ID 0xFFFF
+
+// The texts of one language: 'strings[id]' is the UTF-8 text of StringId 'id'.
+// Define one table per language as const data, e.g.
+//   const char* const EN_STRINGS[] = { "Settings", "Language" };
+//   const StringTable EN = { "en", EN_STRINGS, 2 };
+// On AVR plain const data is copied to RAM; put the texts and the pointer array in
+// flash and set 'progmem':
+//   const char EN_SETTINGS[] PROGMEM = "Settings";
+//   const char EN_LANGUAGE[] PROGMEM = "Language";
+//   const char* const EN_STRINGS[] PROGMEM = { EN_SETTINGS, EN_LANGUAGE };
+//   const StringTable EN = { "en", EN_STRINGS, 2, true };
+struct StringTable {
+  const char* language;         // Language code, e.g. "en"
+  const char* const* strings;   // Texts indexed by StringId
+  uint16_t count;               // Number of entries in 'strings'
+  bool progmem;                 // 'strings' and its texts are PROGMEM
+};
+
+// The active language for all menu items with a StringId.
+// Switching only swaps a pointer and bumps a generation counter; items re-decode
+// their text (see MenuItem::getGlyphs) the next time they are drawn.
+class MenuStrings {
+private:
+  static const StringTable* table;  // Active language (nullptr = none)
+  static uint16_t generation;       // Incremented on every switch, never 0
+
+  // Copies text 'id' of the active PROGMEM table into the decode buffer
+  static const char* getFromFlash(StringId id);
+
+public:
+  // Makes 'strings' the active language
+  static void setTable(const StringTable* strings);
+
+  // Returns the active language
+  static const StringTable* getTable() { return table; }
+
+  // Returns the text of 'id' in the active language ("?" if it has none).
+  // Texts of a PROGMEM table are copied into one shared buffer: the result is valid
+  // until the next call, so use it right away.
+  static const char* get(StringId id) {
+    if (!table || id >= table->count) return "?";
+    if (table->progmem) return getFromFlash(id);
+    return table->strings[id] ? table->strings[id] : "?";
+  }
+
+  // Changes whenever the active language changes; compare to detect stale cached text
+  static uint16_t getGeneration() { return generation; }
+};
+
+#endif // STRING_TABLE_H
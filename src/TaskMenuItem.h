@@ -0,0 +1,176 @@
+#ifndef TASK_MENU_ITEM_H
+#define TASK_MENU_ITEM_H
+
+#include "MenuItem.h"
+#include <stdio.h>   // For snprintf
+#include <string.h>  // For strcmp, memcpy
+
+// Size of the fixed text buffer of a task item (including the terminating '\0')
+#ifndef TASK_ITEM_TEXT_SIZE
+#define TASK_ITEM_TEXT_SIZE 32
+#endif
+
+// Time between two spinner frames of a task without known progress (ms)
+#ifndef TASK_SPINNER_INTERVAL
+#define TASK_SPINNER_INTERVAL 150
+#endif
+
+class TaskMenuItem;
+
+// Step function of a task: does one short piece of work (well below the frame budget,
+// see MenuDisplay::setTaskBudget) and returns true while there is more to do.
+// Keep the position between calls in the task's stage, e.g. a switch over getStage().
+// After cancellation it is called once more with isCancelled() true to clean up.
+using MenuTaskStep = bool(*)(TaskMenuItem& task);
+
+// Menu item starting a long operation (e.g. a WiFi scan) that runs in small steps
+// from MenuDisplay::update(), so rendering and input continue while it works.
+// While running, the item shows its progress ("Scan 42%") or a spinner ("Scan /");
+// only that row is repainted when it changes. Selecting the item again cancels it.
+class TaskMenuItem : public MenuItem {
+private:
+    MenuTaskStep stepFunction = nullptr;  // Work done on each step
+    int stage = 0;                        // Position of the step function in its work
+    int progress = -1;                    // 0..100, or -1 = unknown (spinner)
+    unsigned long startTime = 0;          // Time the task was started (ms)
+    bool running = false;                 // Started and not finished or cancelled
+    bool cancelled = false;               // Stopped by cancelTask()
+    bool showingProgress = false;         // 'text' holds the progress, not the plain label
+    char text[TASK_ITEM_TEXT_SIZE];       // Label followed by the progress or spinner
+    MenuText glyphs;                      // 'text' decoded into glyph indices
+    int labelLength = 0;                  // Label glyphs in 'text'
+
+    // Formats the label and the progress (or the spinner frame at time 'now') into 'buffer'
+    void format(char* buffer, size_t size, unsigned long now) const {
+        if (progress >= 0) {
+            snprintf(buffer, size, "%s %d%%", getLabelText(), progress);
+        } else {
+            static const char frames[] = "|/-\\";
+            snprintf(buffer, size, "%s %c", getLabelText(), frames[(now - startTime) / TASK_SPINNER_INTERVAL % 4]);
+        }
+    }
+
+protected:
+    // Does one piece of the work, returns true while there is more. Calls the step
+    // function; subclasses may override it and keep the task's state in members instead.
+    virtual bool step() {
+        return stepFunction ? stepFunction(*this) : false;
+    }
+
+public:
+    TaskMenuItem(MenuLabel label, MenuTaskStep stepFunction = nullptr)
+        : MenuItem(label), stepFunction(stepFunction) {
+        glyphs.reserve(TASK_ITEM_TEXT_SIZE);  // Progress updates never grow it
+    }
+
+    // Task item with a translated label (the text of 'id' in the active language)
+    TaskMenuItem(StringId id, MenuTaskStep stepFunction = nullptr)
+        : MenuItem(id), stepFunction(stepFunction) {
+        glyphs.reserve(TASK_ITEM_TEXT_SIZE);
+    }
+
+    // ---- Called by the step function ----
+
+    // Position in the task's work; 0 after each start
+    int getStage() const {
+        return stage;
+    }
+
+    void setStage(int value) {
+        stage = value;
+    }
+
+    // Sets the progress shown in the menu (0..100, -1 = unknown, shows a spinner)
+    void setProgress(int percent) {
+        progress = (percent < 0) ? -1 : (percent > 100 ? 100 : percent);
+    }
+
+    int getProgress() const {
+        return progress;
+    }
+
+    // Whether the task is being stopped by the user (the step should release its resources)
+    bool isCancelled() const {
+        return cancelled;
+    }
+
+    // Time the task was started (ms), e.g. for timeouts
+    unsigned long getStartTime() const {
+        return startTime;
+    }
+
+    // ---- Called by MenuDisplay ----
+
+    bool hasTask() const override {
+        return true;
+    }
+
+    // Restarts the task from stage 0
+    bool startTask(unsigned long now) override {
+        stage = 0;
+        progress = -1;
+        startTime = now;
+        cancelled = false;
+        running = true;
+        return true;
+    }
+
+    // Runs one step
+    bool stepTask() override {
+        if (!running) return false;
+        running = step();
+        return running;
+    }
+
+    // Stops the task, giving the step one call to clean up
+    void cancelTask() override {
+        if (!running) return;
+        cancelled = true;
+        step();
+        running = false;
+    }
+
+    bool isTaskRunning() const override {
+        return running;
+    }
+
+    // Returns the label, followed by the progress while the task runs
+    const char* getText() const override {
+        return showingProgress ? text : MenuItem::getText();
+    }
+
+    const MenuText& getGlyphs() const override {
+        return showingProgress ? glyphs : MenuItem::getGlyphs();
+    }
+
+    // Formats the progress or the spinner frame; returns true when the text changed
+    bool refresh(unsigned long now) override {
+        if (!running) {
+            if (!showingProgress) return false;
+            showingProgress = false;  // Finished or cancelled: back to the plain label
+            return true;
+        }
+
+        char next[TASK_ITEM_TEXT_SIZE];
+        format(next, sizeof(next), now);
+        if (showingProgress && strcmp(next, text) == 0) return false;
+
+        memcpy(text, next, sizeof(text));
+        glyphs.assign(text);
+        labelLength = 0;
+        for (const char* c = getLabelText(); *c; ++c) {
+            if ((*c & 0xC0) != 0x80) ++labelLength;  // Count UTF-8 lead bytes only
+        }
+        showingProgress = true;
+        return true;
+    }
+
+    // The progress is the value of label/value layouts
+    int getValueStart(int& labelGlyphs) const override {
+        if (!showingProgress) return -1;
+        labelGlyphs = labelLength;
+        return labelLength + 1;
+    }
+};
+
+#endif // TASK_MENU_ITEM_H